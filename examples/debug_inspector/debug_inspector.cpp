@@ -1121,11 +1121,11 @@ RenderInspectorUI(inspector *Inspector, d3d11_renderer *Renderer)
     }
 
     uint32_t      WindowFlags = Gui_NodeFlags_ClipContent | Gui_NodeFlags_IsDraggable | Gui_NodeFlags_IsResizable;
-    gui_component Window      = GuiCreateComponent(gui_str8_comp("window"), WindowFlags, &WindowStyle, Inspector->LayoutTree);
+    gui_component Window      = GuiCreateComponentWithKey(gui_key_lit("window"), WindowFlags, &WindowStyle, Inspector->LayoutTree);
 
     if(GuiPushComponent(&Window, PushStruct<gui_parent_node>(Inspector->FrameArena)))
     {
-        gui_component TreePanel = GuiCreateComponent(gui_str8_comp("tree_panel"), Gui_NodeFlags_None, &TreePanelStyle, Inspector->LayoutTree);
+        gui_component TreePanel = GuiCreateComponentWithKey(gui_key_lit("tree_panel"), Gui_NodeFlags_None, &TreePanelStyle, Inspector->LayoutTree);
         if(GuiPushComponent(&TreePanel, PushStruct<gui_parent_node>(Inspector->FrameArena)))
         {
             // TODO: Text Experimentation.
@@ -1133,7 +1133,7 @@ RenderInspectorUI(inspector *Inspector, d3d11_renderer *Renderer)
             GuiPopComponent(&TreePanel);
         }
 
-        gui_component OtherPanel = GuiCreateComponent(gui_str8_comp("other_panel"), Gui_NodeFlags_None, &TreePanelStyle, Inspector->LayoutTree);
+        gui_component OtherPanel = GuiCreateComponentWithKey(gui_key_lit("other_panel"), Gui_NodeFlags_None, &TreePanelStyle, Inspector->LayoutTree);
         if(GuiPushComponent(&OtherPanel, PushStruct<gui_parent_node>(Inspector->FrameArena)))
         {
             GuiPopComponent(&OtherPanel);
@@ -0,0 +1,47 @@
+@echo off
+SETLOCAL
+
+:: ------------------------------------
+:: Config
+:: ------------------------------------
+set "CC=clang-cl"
+
+set "TARGET=layout_benchmark.exe"
+set "SRCS=layout_benchmark.c"
+set "INCLUDES="
+set "OUT_DIR=."
+
+:: ------------------------------------
+:: Build type
+:: ------------------------------------
+if /I "%~1"=="debug" (
+    set "BUILD=debug"
+    set "CFLAGS=/Od /Zi /W3 -Wno-unused-function /std:c11 /DDEBUG"
+    set "PDBNAME=layout_benchmark.pdb"
+) else (
+    set "BUILD=release"
+    set "CFLAGS=/O2 /Zi -Wno-unused-function /std:c11"
+    set "PDBNAME=layout_benchmark_release.pdb"
+)
+
+echo Building %TARGET% (%BUILD%)...
+echo CFLAGS: %CFLAGS%
+echo.
+
+:: ------------------------------------
+:: One-step compile + link
+:: ------------------------------------
+"%CC%" %SRCS% ^
+    /I "%INCLUDES%" ^
+    %CFLAGS% ^
+    /Fe"%OUT_DIR%\%TARGET%" ^
+    /link /SUBSYSTEM:CONSOLE /DEBUG /PDB:"%OUT_DIR%\%PDBNAME%"
+
+if errorlevel 1 (
+    echo *** Build failed ***
+    exit /b 1
+)
+
+echo *** BUILD SUCCEEDED: %OUT_DIR%\%TARGET% ***
+ENDLOCAL
+exit /b 0
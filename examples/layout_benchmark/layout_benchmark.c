@@ -0,0 +1,385 @@
+// ====================================================
+// Layout Benchmark
+// ====================================================
+//
+// Measures how many bytes each pass pulls into the cache with the split node
+// storage (topology, inputs, outputs, measures and state in separate arrays) against the
+// previous layout where every field lived in a single ~150 byte node.
+//
+// Both layouts are walked in the same depth-first order and only the fields a
+// pass actually reads are recorded, the difference is only where they live. A
+// touched cache line is counted once per pass. Timings are for the real passes.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stddef.h>
+
+#define GUI_IMPLEMENTATION
+#include "../../gui.h"
+
+#define CACHE_LINE_SIZE 64u
+#define ROW_COUNT       128u
+#define COLUMN_COUNT    15u
+#define NODE_CAPACITY   4096u
+#define ITERATIONS      1000u
+
+
+// ====================================================
+// Previous Node Layout (Reference)
+// ====================================================
+
+typedef struct legacy_layout_node
+{
+    uint32_t            Parent;
+    uint32_t            First;
+    uint32_t            Last;
+    uint32_t            Next;
+    uint32_t            Prev;
+    uint32_t            ChildCount;
+    uint32_t            Index;
+
+    gui_point           OutputPosition;
+    gui_dimensions      OutputSize;
+    gui_dimensions      OutputChildSize;
+
+    gui_size            Size;
+    gui_size            MinSize;
+    gui_size            MaxSize;
+    Gui_Alignment       XAlign;
+    Gui_Alignment       YAlign;
+    Gui_LayoutDirection Direction;
+    gui_padding         Padding;
+    float               Spacing;
+    float               Grow;
+    float               Shrink;
+
+    gui_direction       AnimatedOffset;
+
+    uint32_t            State;
+    uint32_t            Flags;
+
+    uint32_t            Dirty;
+    uint32_t            LastChildCount;
+    gui_dimensions      IntrinsicSize;
+
+    uint32_t            DepthFirstIndex;
+} legacy_layout_node;
+
+
+// ====================================================
+// Cache Line Counter
+// ====================================================
+
+typedef struct line_set
+{
+    uint64_t *Lines;
+    uint32_t  Mask;
+    uint32_t  Count;
+} line_set;
+
+
+static void
+ClearLines(line_set *Set)
+{
+    memset(Set->Lines, 0, (Set->Mask + 1) * sizeof(uint64_t));
+    Set->Count = 0;
+}
+
+
+static void
+TouchLine(line_set *Set, uint64_t Line)
+{
+    // Line + 1 so that zero can mark an empty slot.
+    uint64_t Key  = Line + 1;
+    uint32_t Slot = (uint32_t)(Key * 0x9E3779B97F4A7C15ull >> 40) & Set->Mask;
+
+    while(Set->Lines[Slot] && Set->Lines[Slot] != Key)
+    {
+        Slot = (Slot + 1) & Set->Mask;
+    }
+
+    if(!Set->Lines[Slot])
+    {
+        Set->Lines[Slot] = Key;
+        Set->Count      += 1;
+    }
+}
+
+
+static void
+Touch(line_set *Set, const void *Address, size_t Size)
+{
+    uint64_t First = (uint64_t)(uintptr_t)Address / CACHE_LINE_SIZE;
+    uint64_t Last  = ((uint64_t)(uintptr_t)Address + Size - 1) / CACHE_LINE_SIZE;
+
+    for(uint64_t Line = First; Line <= Last; ++Line)
+    {
+        TouchLine(Set, Line);
+    }
+}
+
+#define TouchField(Set, Struct, Field) Touch(Set, &(Struct)->Field, sizeof((Struct)->Field))
+
+
+// ====================================================
+// Tree Construction
+// ====================================================
+
+static void
+BuildTree(gui_layout_tree *Tree, float RootPadding)
+{
+    gui_layout_properties Root = {0};
+    Root.Size      = (gui_size){{1920.0f, Gui_LayoutSizing_Fixed}, {1080.0f, Gui_LayoutSizing_Fixed}};
+    Root.Direction = Gui_LayoutDirection_Vertical;
+    Root.Padding   = (gui_padding){RootPadding, RootPadding, RootPadding, RootPadding};
+    Root.Spacing   = 2.0f;
+
+    gui_layout_properties Row = {0};
+    Row.Size      = (gui_size){{100.0f, Gui_LayoutSizing_Percent}, {0.0f, Gui_LayoutSizing_Fit}};
+    Row.Direction = Gui_LayoutDirection_Horizontal;
+    Row.Padding   = (gui_padding){2.0f, 2.0f, 2.0f, 2.0f};
+    Row.Spacing   = 4.0f;
+
+    gui_layout_properties Cell = {0};
+    Cell.Size = (gui_size){{64.0f, Gui_LayoutSizing_Fixed}, {6.0f, Gui_LayoutSizing_Fixed}};
+    Cell.Grow = 1.0f;
+
+    gui_paint_properties Paint = {0};
+    Paint.Default.Color       = GuiColorFromRGB8(40, 40, 40, 255);
+    Paint.Default.BorderWidth = 1.0f;
+
+    gui_parent_node RootParent, RowParent;
+
+    gui_node RootNode = GuiCreateNode(1, 0, Tree);
+    GuiUpdateLayout(RootNode, &Root, Tree);
+    GuiUpdateStyle(RootNode, &Paint, Tree);
+    GuiEnterParent(RootNode, Tree, &RootParent);
+
+    for(uint32_t RowIdx = 0; RowIdx < ROW_COUNT; ++RowIdx)
+    {
+        gui_node RowNode = GuiCreateNode(1000 + RowIdx, 0, Tree);
+        GuiUpdateLayout(RowNode, &Row, Tree);
+        GuiUpdateStyle(RowNode, &Paint, Tree);
+        GuiEnterParent(RowNode, Tree, &RowParent);
+
+        for(uint32_t ColumnIdx = 0; ColumnIdx < COLUMN_COUNT; ++ColumnIdx)
+        {
+            gui_node CellNode = GuiCreateNode(100000 + RowIdx * COLUMN_COUNT + ColumnIdx, 0, Tree);
+            GuiUpdateLayout(CellNode, &Cell, Tree);
+            GuiUpdateStyle(CellNode, &Paint, Tree);
+        }
+
+        GuiLeaveParent(RowNode, Tree);
+    }
+
+    GuiLeaveParent(RootNode, Tree);
+}
+
+
+// ====================================================
+// Access Models
+// ====================================================
+
+// Hit-testing reads the pre-order arrays and the output box of every node it visits.
+
+static void
+ModelHitTest(gui_point Position, gui_layout_tree *Tree, legacy_layout_node *Legacy, line_set *Split, line_set *Packed)
+{
+    uint32_t At  = 0;
+    uint32_t End = Tree->DepthFirstCount;
+    while(At < End)
+    {
+        uint32_t           NodeIndex = Tree->DepthFirst[At];
+        gui_layout_output *Output    = &Tree->Outputs[NodeIndex];
+
+        Touch(Split , &Tree->DepthFirst[At]    , sizeof(uint32_t));
+        Touch(Split , &Tree->DepthFirstSize[At], sizeof(uint32_t));
+        Touch(Packed, &Tree->DepthFirst[At]    , sizeof(uint32_t));
+        Touch(Packed, &Tree->DepthFirstSize[At], sizeof(uint32_t));
+
+        TouchField(Split , Output           , Position);
+        TouchField(Split , Output           , Size);
+        TouchField(Packed, &Legacy[NodeIndex], OutputPosition);
+        TouchField(Packed, &Legacy[NodeIndex], OutputSize);
+
+        gui_bounding_box Box = GuiGetLayoutNodeBoundingBox(Output);
+        if(Position.X >= Box.Left && Position.X <= Box.Right && Position.Y >= Box.Top && Position.Y <= Box.Bottom)
+        {
+            End = At + Tree->DepthFirstSize[At];
+            At += 1;
+        }
+        else
+        {
+            At += Tree->DepthFirstSize[At];
+        }
+    }
+}
+
+
+// Painting reads the interaction state, the output box and the paint style of every node.
+
+static void
+ModelPaint(gui_layout_tree *Tree, legacy_layout_node *Legacy, line_set *Split, line_set *Packed)
+{
+    for(uint32_t At = 0; At < Tree->DepthFirstCount; ++At)
+    {
+        uint32_t NodeIndex = Tree->DepthFirst[At];
+
+        Touch(Split , &Tree->DepthFirst[At], sizeof(uint32_t));
+        Touch(Packed, &Tree->DepthFirst[At], sizeof(uint32_t));
+
+        TouchField(Split , &Tree->States[NodeIndex] , State);
+        TouchField(Split , &Tree->Outputs[NodeIndex], Position);
+        TouchField(Split , &Tree->Outputs[NodeIndex], Size);
+        TouchField(Packed, &Legacy[NodeIndex]       , State);
+        TouchField(Packed, &Legacy[NodeIndex]       , OutputPosition);
+        TouchField(Packed, &Legacy[NodeIndex]       , OutputSize);
+
+        Touch(Split , &Tree->PaintBuffer[NodeIndex], sizeof(gui_paint_properties));
+        Touch(Packed, &Tree->PaintBuffer[NodeIndex], sizeof(gui_paint_properties));
+    }
+}
+
+
+// A full arrange reads everything, it is the worst case for the split layout.
+
+static void
+ModelArrange(gui_layout_tree *Tree, legacy_layout_node *Legacy, line_set *Split, line_set *Packed)
+{
+    for(uint32_t At = 0; At < Tree->DepthFirstCount; ++At)
+    {
+        uint32_t NodeIndex = Tree->DepthFirst[At];
+
+        Touch(Split , &Tree->DepthFirst[At]     , sizeof(uint32_t));
+        Touch(Packed, &Tree->DepthFirst[At]     , sizeof(uint32_t));
+
+        Touch(Split , &Tree->Nodes[NodeIndex]   , sizeof(gui_layout_node));
+        Touch(Split , &Tree->Inputs[NodeIndex]  , sizeof(gui_layout_input));
+        Touch(Split , &Tree->Outputs[NodeIndex] , sizeof(gui_layout_output));
+        Touch(Split , &Tree->Measures[NodeIndex], sizeof(gui_layout_measure));
+        Touch(Split , &Tree->States[NodeIndex]  , sizeof(gui_layout_state));
+        Touch(Packed, &Legacy[NodeIndex]        , sizeof(legacy_layout_node));
+    }
+}
+
+
+// ====================================================
+// Timing
+// ====================================================
+
+static double
+GetSeconds(void)
+{
+    struct timespec Time;
+    timespec_get(&Time, TIME_UTC);
+
+    double Result = (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+    return Result;
+}
+
+
+static void
+PrintPass(const char *Name, line_set *Split, line_set *Packed, double Seconds)
+{
+    uint64_t SplitBytes  = (uint64_t)Split->Count  * CACHE_LINE_SIZE;
+    uint64_t PackedBytes = (uint64_t)Packed->Count * CACHE_LINE_SIZE;
+
+    printf("%-10s %12llu %12llu %9.2fx %10.2f us\n", Name,
+           (unsigned long long)PackedBytes, (unsigned long long)SplitBytes,
+           SplitBytes ? (double)PackedBytes / (double)SplitBytes : 0.0,
+           Seconds * 1e6 / (double)ITERATIONS);
+}
+
+
+int main(void)
+{
+    gui_memory_footprint Footprint = GuiGetLayoutTreeFootprint(NODE_CAPACITY);
+    gui_memory_block     Block     = {0};
+
+    Block.SizeInBytes = Footprint.SizeInBytes;
+    Block.Base        = calloc(1, Footprint.SizeInBytes + Footprint.Alignment);
+    Block.Base        = (void *)GUI_ALIGN_POW2((uintptr_t)Block.Base, Footprint.Alignment);
+
+    gui_layout_tree *Tree = GuiPlaceLayoutTreeInMemory(NODE_CAPACITY, Block);
+    if(!Tree)
+    {
+        printf("Failed to place the layout tree.\n");
+        return 1;
+    }
+
+    BuildTree(Tree, 4.0f);
+    GuiComputeTreeLayout(Tree);
+
+    legacy_layout_node *Legacy = calloc(NODE_CAPACITY, sizeof(legacy_layout_node));
+
+    line_set Split  = {.Lines = calloc(1u << 16, sizeof(uint64_t)), .Mask = (1u << 16) - 1};
+    line_set Packed = {.Lines = calloc(1u << 16, sizeof(uint64_t)), .Mask = (1u << 16) - 1};
+
+    printf("nodes %u, node sizes: packed %zu bytes, split %zu + %zu + %zu + %zu + %zu bytes\n\n",
+           Tree->NodeCount, sizeof(legacy_layout_node), sizeof(gui_layout_node), sizeof(gui_layout_input),
+           sizeof(gui_layout_output), sizeof(gui_layout_measure), sizeof(gui_layout_state));
+
+    printf("%-10s %12s %12s %10s %13s\n", "pass", "packed (B)", "split (B)", "ratio", "time");
+
+    // Hit-test
+
+    gui_point Pointer = {.X = 900.0f, .Y = 540.0f};
+    double    Start   = GetSeconds();
+    uint32_t  Hit     = 0;
+
+    for(uint32_t Iteration = 0; Iteration < ITERATIONS; ++Iteration)
+    {
+        Hit += GuiFindHitNode(Pointer, Tree);
+    }
+
+    double HitSeconds = GetSeconds() - Start;
+
+    ClearLines(&Split);
+    ClearLines(&Packed);
+    ModelHitTest(Pointer, Tree, Legacy, &Split, &Packed);
+    PrintPass("hit-test", &Split, &Packed, HitSeconds);
+
+    // Paint
+
+    gui_render_command_params Params   = {.Count = GuiGetRenderCommandCount((gui_render_command_params){0}, Tree)};
+    gui_memory_footprint      Commands = GuiGetRenderCommandsFootprint(Params, Tree);
+    gui_memory_block          Scratch  = {.SizeInBytes = Commands.SizeInBytes, .Base = calloc(1, Commands.SizeInBytes)};
+
+    Start = GetSeconds();
+
+    for(uint32_t Iteration = 0; Iteration < ITERATIONS; ++Iteration)
+    {
+        GuiComputeRenderCommands(Params, Tree, Scratch);
+    }
+
+    double PaintSeconds = GetSeconds() - Start;
+
+    ClearLines(&Split);
+    ClearLines(&Packed);
+    ModelPaint(Tree, Legacy, &Split, &Packed);
+    PrintPass("paint", &Split, &Packed, PaintSeconds);
+
+    // Full relayout, the root padding changes every frame so every node is placed again.
+
+    Start = GetSeconds();
+
+    for(uint32_t Iteration = 0; Iteration < ITERATIONS; ++Iteration)
+    {
+        BuildTree(Tree, (Iteration & 1) ? 4.0f : 6.0f);
+        GuiComputeTreeLayout(Tree);
+    }
+
+    double LayoutSeconds = GetSeconds() - Start;
+
+    ClearLines(&Split);
+    ClearLines(&Packed);
+    ModelArrange(Tree, Legacy, &Split, &Packed);
+    PrintPass("layout", &Split, &Packed, LayoutSeconds);
+
+    printf("\n(hit %u)\n", Hit);
+
+    return 0;
+}
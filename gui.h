@@ -34,12 +34,14 @@ extern "C" {
 typedef struct gui_resource_table gui_resource_table;
 typedef struct gui_pointer_event_list gui_pointer_event_list;
 typedef struct gui_layout_tree        gui_layout_tree;
+typedef struct gui_paint_properties   gui_paint_properties;
 
 
 //-----------------------------------------------------------------------------
 // [SECTION] GUI BASIC PRIMITIVES
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 Slot generation in gui_node
 // : - 2026-01-16 Added the tree on the node to simplify the APIs
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
@@ -50,9 +52,14 @@ typedef uint32_t gui_bool;
 #define GUI_FALSE (0u)
 
 
+// Node slots are reused once a node is freed. The generation of the slot is kept
+// in the handle, a handle whose node was freed does not resolve to the next node
+// living in the same slot.
+
 typedef struct gui_node
 {
     uint32_t         Value;
+    uint32_t         Generation;
     gui_layout_tree *Tree;
 } gui_node;
 
@@ -170,13 +177,16 @@ GUI_API gui_bool GuiPushPointerReleaseEvent  (Gui_PointerButton Button, gui_poin
 // [SECTION] GUI RESOURCE API
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 EvictLeastRecent table parameter
+// : - 2026-10-17 Layout subtree resource type
 // : - 2026-01-12 Basic Implementation
 //-----------------------------------------------------------------------------
 
 
 typedef enum Gui_ResourceType
 {
-    Gui_ResourceType_None = 0,
+    Gui_ResourceType_None          = 0,
+    Gui_ResourceType_LayoutSubtree = 1,
 } Gui_ResourceType;
 
 
@@ -205,6 +215,7 @@ typedef struct gui_resource_table_params
 {
     uint32_t HashSlotCount;
     uint32_t EntryCount;
+    gui_bool EvictLeastRecent;
 } gui_resource_table_params;
 
 
@@ -221,6 +232,17 @@ GUI_API gui_resource_stats     GuiGetResourceStats            (gui_bool ClearSta
 // [SECTION] GUI LAYOUT API
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 Parent seeds and GuiGetChildKey
+// : - 2026-10-17 Reference map lookup, probe and rebuild counters
+// : - 2026-10-17 GuiCreateNodes
+// : - 2026-10-17 Tree growth and the growth callback
+// : - 2026-10-17 Freed node counter
+// : - 2026-10-17 Layout change journal
+// : - 2026-10-17 Boundary relayout counter
+// : - 2026-10-17 Virtual lists
+// : - 2026-10-17 Wrap option for horizontal and vertical directions
+// : - 2026-10-17 Grid direction and track sizing
+// : - 2026-10-17 Host-driven parallel layout parameters
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -250,15 +272,17 @@ typedef enum Gui_LayoutDirection
     Gui_LayoutDirection_None       = 0,
     Gui_LayoutDirection_Horizontal = 1,
     Gui_LayoutDirection_Vertical   = 2,
+    Gui_LayoutDirection_Grid       = 3,
 } Gui_LayoutDirection;
 
 
 typedef enum Gui_LayoutSizing
 {
-    Gui_LayoutSizing_None    = 0,
-    Gui_LayoutSizing_Fixed   = 1,
-    Gui_LayoutSizing_Percent = 2,
-    Gui_LayoutSizing_Fit     = 3,
+    Gui_LayoutSizing_None     = 0,
+    Gui_LayoutSizing_Fixed    = 1,
+    Gui_LayoutSizing_Percent  = 2,
+    Gui_LayoutSizing_Fit      = 3,
+    Gui_LayoutSizing_Fraction = 4,
 } Gui_LayoutSizing;
 
 
@@ -282,6 +306,22 @@ typedef struct gui_padding
 } gui_padding;
 
 
+// A grid node places its children row by row into cells, ColumnCount children per
+// row. Each track is a regular sizing: fixed, percent of the content box, fit to
+// the largest child in the track, or a fraction of the space the other tracks leave.
+// Children past the last row track go into extra rows sized to fit.
+
+#define GUI_MAX_GRID_TRACKS 8
+
+typedef struct gui_grid_tracks
+{
+    gui_sizing Columns[GUI_MAX_GRID_TRACKS];
+    gui_sizing Rows[GUI_MAX_GRID_TRACKS];
+    uint32_t   ColumnCount;
+    uint32_t   RowCount;
+} gui_grid_tracks;
+
+
 typedef struct gui_layout_properties
 {
     gui_size             Size;
@@ -297,33 +337,145 @@ typedef struct gui_layout_properties
 
     float                Grow;
     float                Shrink;
+    gui_bool             Wrap;
+
+    gui_grid_tracks      Grid;
 } gui_layout_properties;
 
 
+// Entering a parent pushes its key as the seed of the keys declared below it. A
+// child keyed with GuiGetChildKey is unique by construction as long as its local
+// key is unique among its siblings, so a plain index or a pre-hashed literal is
+// enough and nothing has to be formatted or hashed per frame.
+
 typedef struct gui_parent_node gui_parent_node;
 struct gui_parent_node
 {
     gui_parent_node *Prev;
     uint32_t         Value;
+    uint64_t         Seed;
 };
 
 
+typedef struct gui_layout_stats
+{
+    uint64_t MeasuredCount;
+    uint64_t ArrangedCount;
+    uint64_t SizingCycleCount;
+    uint64_t WrapRemeasureCount;
+    uint64_t BoundaryRelayoutCount;
+    uint64_t FreedCount;
+    uint64_t ReferenceLookupCount;
+    uint64_t ReferenceProbeCount;
+    uint64_t ReferenceMaxProbe;
+    uint64_t ReferenceRebuildCount;
+} gui_layout_stats;
+
+
+// The library does not own threads. To lay out large trees in parallel, the host
+// provides a parallel-for: it must call Task(Data, Index) for every Index in
+// [0, TaskCount), on any threads it likes, and only return once all calls are done.
+// Subtrees with fewer than TaskSize nodes are never split, and trees with fewer than
+// MinTreeSize nodes are laid out on the calling thread. The output is identical to
+// the serial path.
+
+typedef void gui_layout_task_proc(void *Data, uint32_t Index);
+typedef void gui_parallel_for_proc(gui_layout_task_proc *Task, void *Data, uint32_t TaskCount, void *UserData);
+
+typedef struct gui_layout_parallel_params
+{
+    gui_parallel_for_proc *ParallelFor;
+    void                  *UserData;
+    uint32_t               TaskSize;
+    uint32_t               MinTreeSize;
+} gui_layout_parallel_params;
+
+
+// A tree can be moved into a larger block while it is alive. Only its arrays move,
+// the tree itself stays where it was placed, so the first block must outlive it.
+// Node indices, handles and keys stay valid. The growth callback is called when
+// the tree runs out of nodes or grid slots, with a suggested NodeCount, and should
+// allocate GuiGetLayoutTreeGrowthFootprint(NodeCount) and call GuiGrowLayoutTree.
+// The block given to a previous growth can be released once it returns. A tree
+// with a front buffer attached only grows if that buffer can hold NodeCount nodes:
+// the callback should attach a larger one with GuiSetFrontBuffer first, otherwise
+// the growth fails and so does the declaration that triggered it. A grid that gets
+// no slot is laid out as a vertical list until it is declared with one free.
+
+typedef gui_bool gui_grow_tree_proc(gui_layout_tree *Tree, uint32_t NodeCount, void *UserData);
+
+
+// The journal lists the nodes whose position or size changed during a frame's
+// layout, each node at most once. It lives in caller-provided transient memory and
+// is detached by GuiBeginFrame. When more nodes changed than it can hold, it is
+// marked incomplete and the caller should assume that everything changed.
+
+typedef struct gui_layout_journal
+{
+    uint32_t *Nodes;
+    uint32_t  Count;
+    uint32_t  Capacity;
+    gui_bool  IsComplete;
+} gui_layout_journal;
+
+
+// A virtual list only creates the rows that intersect its viewport. Rows are laid
+// out RowHeight apart, an estimate is fine when rows fit their content. Row nodes
+// are recycled as the list scrolls: a row's children must be keyed from Row.Key,
+// which GuiGetChildKey does when called from BuildRow, so that they are recycled
+// with it. A fixed list size is used as declared, a percent or fit one is the
+// list's last arranged size, so the rows lag a frame behind a resize.
+
+typedef struct gui_virtual_row
+{
+    uint32_t Index;
+    uint64_t Key;
+    gui_node Node;
+} gui_virtual_row;
+
+typedef void gui_build_row_proc(gui_virtual_row Row, void *UserData);
+
+typedef struct gui_virtual_list_params
+{
+    uint32_t            RowCount;
+    float               RowHeight;
+    float               ScrollOffset;
+    gui_build_row_proc *BuildRow;
+    void               *UserData;
+} gui_virtual_list_params;
+
+
 GUI_API gui_memory_footprint GuiGetLayoutTreeFootprint   (uint32_t NodeCount);
 GUI_API gui_layout_tree    * GuiPlaceLayoutTreeInMemory  (uint32_t NodeCount, gui_memory_block Block);
 
+GUI_API gui_memory_footprint GuiGetLayoutTreeGrowthFootprint (uint32_t NodeCount);
+GUI_API gui_bool             GuiGrowLayoutTree               (uint32_t NodeCount, gui_memory_block Block, gui_layout_tree *Tree);
+GUI_API void                 GuiSetLayoutTreeGrowth          (gui_grow_tree_proc *Grow, void *UserData, gui_layout_tree *Tree);
+
 
 GUI_API gui_node             GuiCreateNode               (uint64_t Key, uint32_t Flags, gui_layout_tree *Tree);
+GUI_API uint32_t             GuiCreateNodes              (uint64_t *Keys, uint32_t Count, uint32_t Flags, gui_layout_properties *Layout, gui_paint_properties *Paint, gui_node *Nodes, gui_layout_tree *Tree);
 GUI_API void                 GuiUpdateLayout             (gui_node Node, gui_layout_properties *Properties, gui_layout_tree *Tree);
 
 
 GUI_API gui_bool             GuiEnterParent              (gui_node Node, gui_layout_tree *Tree, gui_parent_node *ParentNode);
 GUI_API void                 GuiLeaveParent              (gui_node Node, gui_layout_tree *Tree);
+GUI_API uint64_t             GuiGetChildKey              (uint64_t LocalKey, gui_layout_tree *Tree);
 
 
 GUI_API gui_bool             GuiAppendChild              (uint32_t ParentIndex, uint32_t ChildIndex, gui_layout_tree *Tree);
 GUI_API uint32_t             GuiFindChild                (gui_node Node, uint32_t FindIndex, gui_layout_tree *Tree);
+GUI_API uint32_t             GuiBuildVirtualList         (gui_node Node, gui_virtual_list_params Params, gui_layout_tree *Tree);
 
 GUI_API void                 GuiComputeTreeLayout        (gui_layout_tree *Tree);
+GUI_API void                 GuiSetLayoutParallelism     (gui_layout_parallel_params Params, gui_layout_tree *Tree);
+GUI_API void                 GuiSetLayoutCache           (gui_resource_table *Table, gui_layout_tree *Tree);
+GUI_API gui_layout_stats     GuiGetLayoutStats           (gui_bool ClearStats, gui_layout_tree *Tree);
+
+
+GUI_API gui_memory_footprint GuiGetLayoutJournalFootprint   (uint32_t Capacity);
+GUI_API gui_layout_journal * GuiPlaceLayoutJournalInMemory  (uint32_t Capacity, gui_memory_block Block);
+GUI_API void                 GuiSetLayoutJournal            (gui_layout_journal *Journal, gui_layout_tree *Tree);
 
 
 //-----------------------------------------------------------------------------
@@ -384,6 +536,7 @@ GuiAnimatePosition(gui_node Node, uint32_t Slot, gui_direction Offset, float Dur
 // [SECTION] GUI PAINTING API
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 Front buffer for painting on another thread
 // : - 2026-01-12 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -464,6 +617,23 @@ typedef struct gui_render_command_params
 } gui_render_command_params;
 
 
+// A front buffer lets the host paint a frame on one thread while the next one is
+// built and laid out on another. GuiBeginFrame publishes the last frame into it:
+// the box of every node in the tree, the paint order and the style each node is
+// painted with. Once attached, the render command functions only read the front
+// buffer and can run concurrently with the build, until the next GuiBeginFrame.
+
+typedef struct gui_front_buffer
+{
+    gui_bounding_box *Boxes;
+    uint32_t         *Order;
+    gui_paint_style  *Styles;
+    uint32_t          OrderCount;
+    uint32_t          NodeCapacity;
+    uint64_t          FrameIndex;
+} gui_front_buffer;
+
+
 GUI_API gui_color              GuiColorFromRGB8               (uint8_t R, uint8_t G, uint8_t B, uint8_t A);
 GUI_API void                   GuiUpdateStyle                 (gui_node Node, gui_paint_properties *Properties, gui_layout_tree *Tree);
 
@@ -471,6 +641,10 @@ GUI_API uint32_t               GuiGetRenderCommandCount       (gui_render_comman
 GUI_API gui_memory_footprint   GuiGetRenderCommandsFootprint  (gui_render_command_params Params, gui_layout_tree *Tree);
 GUI_API gui_render_command   * GuiComputeRenderCommands       (gui_render_command_params Params, gui_layout_tree *Tree, gui_memory_block Block);
 
+GUI_API gui_memory_footprint   GuiGetFrontBufferFootprint     (uint32_t NodeCount);
+GUI_API gui_front_buffer     * GuiPlaceFrontBufferInMemory    (uint32_t NodeCount, gui_memory_block Block);
+GUI_API void                   GuiSetFrontBuffer              (gui_front_buffer *Buffer, gui_layout_tree *Tree);
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] GUI CONTEXT API
@@ -492,6 +666,8 @@ GUI_API void GuiEndFrame    (void);
 // [SECTION] BASE MACROS/HELPERS FOR INTERNAL USE
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 GUI_DEBUG_ASSERT, enabled by GUI_DEBUG
+// : - 2026-10-17 SSE2 detection, GUI_NO_SIMD opt-out
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -524,9 +700,24 @@ GUI_API void GuiEndFrame    (void);
     #define GUI_DEBUGBREAK() __builtin_trap()
 #endif
 
+// SSE2 is part of the x64 baseline. Define GUI_NO_SIMD to force the scalar paths.
+
+#if !defined(GUI_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define GUI_SSE2 1
+    #include <emmintrin.h>
+#endif
+
 #define GUI_ASSERT(Cond)        do { if (!(Cond))  GUI_DEBUGBREAK(); } while (0)
 #define GUI_UNUSED(X)           (void)(X)
 
+// Define GUI_DEBUG to trap on misuse that is otherwise ignored, like stale node handles.
+
+#if defined(GUI_DEBUG)
+    #define GUI_DEBUG_ASSERT(Cond) GUI_ASSERT(Cond)
+#else
+    #define GUI_DEBUG_ASSERT(Cond) do { } while (0)
+#endif
+
 
 #define GUI_KILOBYTE(n)         (((uint64_t)(n)) << 10)
 #define GUI_MEGABYTE(n)         (((uint64_t)(n)) << 20)
@@ -760,6 +951,7 @@ typedef struct gui_resource_table
     uint32_t               HashMask;
     uint32_t               HashSlotCount;
     uint32_t               EntryCount;
+    gui_bool               EvictLeastRecent;
 
     uint32_t              *HashTable;
     gui_resource_entry    *Entries;
@@ -770,6 +962,7 @@ typedef struct gui_resource_table
 // [SECTION] RESOURCES INTERNAL IMPLEMENTATION
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 Tables placed with EvictLeastRecent recycle their least recently used entry
 // : - 2026-01-12 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -812,12 +1005,35 @@ GuiPopFreeResourceEntry(gui_resource_table *Table)
 
     // At initialization we populate sentinel's the hash chain such that:
     // (Sentinel) -> (Slot) -> (Slot) -> (Slot)
-    // If (Sentinel) -> (Nothing), then we have no more slots available.
+    // If (Sentinel) -> (Nothing), then we have no more slots available. Tables that
+    // opted in recycle the least recently used entry, the tail of the LRU chain.
 
-    if(!Sentinel->NextWithSameHashSlot)
+    if(!Sentinel->NextWithSameHashSlot && !Table->EvictLeastRecent)
     {
         GUI_ASSERT(!"Not Implemented");
     }
+    else if(!Sentinel->NextWithSameHashSlot)
+    {
+        uint32_t Evicted = Sentinel->PrevLRU;
+        GUI_ASSERT(Evicted);
+
+        gui_resource_entry *Entry = GuiGetResourceEntry(Evicted, Table);
+        GuiGetResourceEntry(Entry->PrevLRU, Table)->NextLRU = Entry->NextLRU;
+        GuiGetResourceEntry(Entry->NextLRU, Table)->PrevLRU = Entry->PrevLRU;
+
+        uint32_t *Link = GuiGetResourceSlotPointer(Entry->Key, Table);
+        while(*Link != Evicted)
+        {
+            Link = &GuiGetResourceEntry(*Link, Table)->NextWithSameHashSlot;
+        }
+        *Link = Entry->NextWithSameHashSlot;
+
+        Entry->NextWithSameHashSlot    = 0;
+        Entry->ResourceType            = Gui_ResourceType_None;
+        Entry->Memory                  = 0;
+        Entry->MemorySize              = 0;
+        Sentinel->NextWithSameHashSlot = Evicted;
+    }
 
     uint32_t Result = Sentinel->NextWithSameHashSlot;
 
@@ -872,11 +1088,12 @@ GuiPlaceResourceTableInMemory(gui_resource_table_params Params, gui_memory_block
 
         if(Entries && HashTable && Table)
         {
-            Table->HashTable     = HashTable;
-            Table->Entries       = Entries;
-            Table->EntryCount    = Params.EntryCount;
-            Table->HashSlotCount = Params.HashSlotCount;
-            Table->HashMask      = Params.HashSlotCount - 1;
+            Table->HashTable        = HashTable;
+            Table->Entries          = Entries;
+            Table->EntryCount       = Params.EntryCount;
+            Table->HashSlotCount    = Params.HashSlotCount;
+            Table->HashMask         = Params.HashSlotCount - 1;
+            Table->EvictLeastRecent = Params.EvictLeastRecent;
 
             for(uint32_t Idx = 0; Idx < Params.HashSlotCount; ++Idx)
             {
@@ -897,6 +1114,8 @@ GuiPlaceResourceTableInMemory(gui_resource_table_params Params, gui_memory_block
     
                 Entry->ResourceType = Gui_ResourceType_None;
                 Entry->Memory       = 0;
+                Entry->NextLRU      = 0;
+                Entry->PrevLRU      = 0;
             }
 
             Result = Table;
@@ -1022,6 +1241,21 @@ GuiGetResourceStats(gui_bool ClearStats, gui_resource_table *Table)
 // [DESCRIP] All types used as part of the layout code that are useless to
 //           the user.
 // [HISTORY]
+// : - 2026-10-18 Grids move to a pool indexed from the node's input
+// : - 2026-10-18 Layout-only sizes and the subtree hash move to a measure array
+// : - 2026-10-17 Depth-first scratch shared by measure and the flex solve
+// : - 2026-10-17 Measure stack and stale wrap lists
+// : - 2026-10-17 Reference map tags, group mask and deleted count
+// : - 2026-10-17 Growth callback on the tree
+// : - 2026-10-17 Node slots carry a generation
+// : - 2026-10-17 Retain lists for the frame-stamped sweep
+// : - 2026-10-17 Optional front buffer on the tree
+// : - 2026-10-17 Moved dirty flag and the tree's change journal
+// : - 2026-10-17 Relayout boundary queue
+// : - 2026-10-17 Content offset, children are placed relative to it
+// : - 2026-10-17 Cached line breaks for wrapping nodes
+// : - 2026-10-17 Per-node grid tracks and measured track sizes
+// : - 2026-10-17 Split the node into topology, input, output and state arrays
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -1042,6 +1276,30 @@ typedef enum Gui_NodeState
 } Gui_NodeState;
 
 
+// Dirty flags drive incremental layout. A node flagged Measure must recompute
+// its size, a node flagged Place must re-place its children and Descendant
+// means that something below the node is dirty. Descendant is propagated up to
+// the root, or to the nearest relayout boundary, so clean subtrees can be skipped
+// entirely. Measuring consumes Measure and Descendant, a node that had dirty
+// descendants keeps Place so the arrange walk still comes down to them. Moved is
+// set along with Place when the node's own position or size changed, until it is
+// journaled.
+
+typedef enum Gui_LayoutDirty
+{
+    Gui_LayoutDirty_None       = 0,
+    Gui_LayoutDirty_Measure    = 1 << 0,
+    Gui_LayoutDirty_Place      = 1 << 1,
+    Gui_LayoutDirty_Descendant = 1 << 2,
+    Gui_LayoutDirty_Moved      = 1 << 3,
+} Gui_LayoutDirty;
+
+
+// A node is split across five arrays indexed by the same node index, grouped by
+// which passes read them. Hit-testing and painting only touch the outputs and the
+// state, the inputs and the measures are only read by layout. Grid tracks and
+// wrapped lines get their own arrays, they are only read for nodes that use them.
+
 typedef struct gui_layout_node
 {
     uint32_t            Parent;
@@ -1050,12 +1308,15 @@ typedef struct gui_layout_node
     uint32_t            Next;
     uint32_t            Prev;
     uint32_t            ChildCount;
+    uint32_t            LastChildCount;
     uint32_t            Index;
+    uint32_t            DepthFirstIndex;
+    uint32_t            Generation;
+} gui_layout_node;
 
-    gui_point           OutputPosition;
-    gui_dimensions      OutputSize;
-    gui_dimensions      OutputChildSize;
 
+typedef struct gui_layout_input
+{
     gui_size            Size;
     gui_size            MinSize;
     gui_size            MaxSize;
@@ -1064,12 +1325,116 @@ typedef struct gui_layout_node
     Gui_LayoutDirection Direction;
     gui_padding         Padding;
     float               Spacing;
+    float               Grow;
+    float               Shrink;
+    gui_bool            Wrap;
 
     gui_direction       AnimatedOffset;
+    gui_direction       ContentOffset;
+
+    uint32_t            GridIndex;
+} gui_layout_input;
 
+
+typedef struct gui_layout_output
+{
+    gui_point           Position;
+    gui_dimensions      Size;
+} gui_layout_output;
+
+
+typedef struct gui_layout_measure
+{
+    gui_dimensions      ChildSize;
+    gui_dimensions      IntrinsicSize;
+    uint64_t            SubtreeHash;
+} gui_layout_measure;
+
+
+typedef struct gui_layout_state
+{
     uint32_t            State;
     uint32_t            Flags;
-} gui_layout_node;
+    uint32_t            Dirty;
+} gui_layout_state;
+
+
+// What a grid's tracks need from its children is collected by the measure pass,
+// so arranging a grid is a single pass over its children. Extra rows are sized
+// from the children in them while they are placed. Grids live in a pool of their
+// own, a grid node holds a slot for as long as it is a grid. Free slots are
+// linked through NextFree.
+
+typedef struct gui_layout_grid
+{
+    gui_grid_tracks     Tracks;
+    float               ColumnFit[GUI_MAX_GRID_TRACKS];
+    float               RowFit[GUI_MAX_GRID_TRACKS];
+    float               ExtraRowHeight;
+    uint32_t            RowCount;
+    uint32_t            NextFree;
+} gui_layout_grid;
+
+
+// Line breaks of a wrapping node are kept between frames. The node records the
+// content size the lines were broken against, each line is stored on its first
+// child and tagged with the node and a stamp, so a stale line is never trusted.
+// The stamp is bumped whenever the node's child list changes, since a line only
+// records how many children follow its first one.
+
+typedef struct gui_layout_wrap
+{
+    float               BreakSize;
+    float               MeasuredExtent;
+    gui_dimensions      LinesSize;
+    uint32_t            Stamp;
+    gui_bool            IsStale;
+    uint32_t            NextStale;
+
+    uint32_t            LineOwner;
+    uint32_t            LineStamp;
+    uint32_t            LineCount;
+    float               LineMajor;
+    float               LineMinor;
+} gui_layout_wrap;
+
+
+// Every node is on one of two lists: the nodes declared this frame and the nodes
+// declared last frame that were not declared again yet. Declaring a node moves it
+// to the first list. GuiBeginFrame frees whatever is left on the second one and
+// starts a new frame, so the sweep only visits the nodes it frees.
+
+typedef struct gui_layout_retain
+{
+    uint64_t            Key;
+    uint32_t            Stamp;
+    uint32_t            Prev;
+    uint32_t            Next;
+} gui_layout_retain;
+
+
+// A node whose size does not depend on its content is a relayout boundary: what
+// happens below it cannot move or resize anything outside of it. Dirty flags stop
+// at the first boundary above a change, the boundary is queued and laid out on its
+// own. When the queue is full, flags propagate to the root as usual.
+
+#define GUI_MAX_RELAYOUT_ROOTS 64
+
+
+// A task is a contiguous range of the depth-first order made of whole subtrees.
+// Tasks never overlap, so they can be measured and arranged concurrently. Each
+// keeps its own counters, they are folded into the tree's once the pass is done.
+
+#define GUI_MAX_LAYOUT_TASKS 128
+
+typedef struct gui_layout_task
+{
+    uint32_t         Begin;
+    uint32_t         End;
+    gui_bool         HasMoved;
+    uint32_t         StaleWraps;
+    gui_layout_stats Stats;
+} gui_layout_task;
 
 
 typedef struct gui_layout_tree
@@ -1077,16 +1442,58 @@ typedef struct gui_layout_tree
     // Persistent State
 
     gui_layout_node        *Nodes;
+    gui_layout_input       *Inputs;
+    gui_layout_output      *Outputs;
+    gui_layout_measure     *Measures;
+    gui_layout_state       *States;
+    gui_layout_wrap        *Wraps;
+    gui_layout_retain      *Retains;
     uint32_t                NodeCount;
     uint32_t                NodeCapacity;
     gui_paint_properties   *PaintBuffer;
 
+    // Grid Pool (Indexed by gui_layout_input::GridIndex)
+
+    gui_layout_grid        *Grids;
+    uint32_t                GridCapacity;
+    uint32_t                FreeGrid;
+
     // Reference Map
 
-    uint64_t                RefHashMask;
+    uint64_t                RefGroupMask;
+    uint64_t                RefDeletedCount;
+    uint8_t                *RefTags;
     uint64_t               *RefKeys;
     uint32_t               *RefValues;
 
+    // Depth-First Order (Rebuilt when the topology changes)
+
+    uint32_t               *DepthFirst;
+    uint32_t               *DepthFirstSize;
+    uint32_t               *DepthFirstScratch;
+    uint32_t                DepthFirstCount;
+    gui_bool                IsTopologyDirty;
+
+    // Growth (Optional, called when the free list or the grid pool is empty)
+
+    gui_grow_tree_proc     *Grow;
+    void                   *GrowUserData;
+
+    // Garbage Collection (Nodes not declared during a frame are freed by the next GuiBeginFrame)
+
+    uint32_t                FrameStamp;
+    uint32_t                TouchedFirst;
+    uint32_t                StaleFirst;
+
+    // Relayout Boundaries (Dirty boundaries whose ancestors are clean)
+
+    uint32_t                RelayoutRoots[GUI_MAX_RELAYOUT_ROOTS];
+    uint32_t                RelayoutRootCount;
+
+    // Stale Wraps (Wrapping nodes to measure again, linked through gui_layout_wrap)
+
+    uint32_t                StaleWrapFirst;
+
     // Transient State
 
     uint32_t                RootIndex;
@@ -1097,6 +1504,29 @@ typedef struct gui_layout_tree
     
     gui_position_animation  Animations[64];
     uint32_t                AnimationCount;
+
+    // Parallel Layout (Tasks are rebuilt with the depth-first order)
+
+    gui_layout_parallel_params Parallel;
+    gui_layout_task         Tasks[GUI_MAX_LAYOUT_TASKS];
+    uint32_t                TaskCount;
+    gui_bool                AreTasksDirty;
+
+    // Layout Cache (Optional, not owned)
+
+    gui_resource_table     *LayoutCache;
+
+    // Change Journal (Optional, not owned, detached every frame)
+
+    gui_layout_journal     *Journal;
+
+    // Front Buffer (Optional, not owned, published by GuiBeginFrame)
+
+    gui_front_buffer       *Front;
+
+    // Diagnostics
+
+    gui_layout_stats        Stats;
 } gui_layout_tree;
 
 
@@ -1104,6 +1534,18 @@ typedef struct gui_layout_tree
 // [SECTION] MISC LAYOUT HELPERS
 // [DESCRIP] Various Node/Tree helpers
 // [HISTORY]
+// : - 2026-10-18 Grid slots are taken and released along with the grid direction
+// : - 2026-10-18 Changing a child list invalidates the parent's cached lines
+// : - 2026-10-17 Running out of free nodes asks the growth callback
+// : - 2026-10-17 Handles are resolved against the slot generation
+// : - 2026-10-17 New nodes start off both retain lists
+// : - 2026-10-17 Child lists are reconciled against last frame instead of relinked
+// : - 2026-10-17 Journal nodes whose position or size changed
+// : - 2026-10-17 Dirty flags stop at relayout boundaries
+// : - 2026-10-17 Wrap is part of the hashed and compared inputs
+// : - 2026-10-17 Grid tracks are hashed and compared with the inputs
+// : - 2026-10-17 Depth-first order rebuilt on topology changes
+// : - 2026-10-17 Dirty flag propagation
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -1150,545 +1592,2911 @@ GuiGetLayoutNode(uint32_t Index, gui_layout_tree *Tree)
 }
 
 
+// Public entry points resolve handles through this. A stale handle resolves to no
+// node, so the call does nothing, and traps when GUI_DEBUG is defined.
+
 static gui_layout_node *
-GuiGetFreeLayoutNode(gui_layout_tree *Tree)
+GuiGetLayoutNodeFromHandle(gui_node Handle, gui_layout_tree *Tree)
 {
-    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
-
-    gui_layout_node *Sentinel = GuiGetSentinelNode(Tree);
-    gui_layout_node *Result   = 0;
-
-    GUI_ASSERT(Sentinel);
+    gui_layout_node *Result = GuiGetLayoutNode(Handle.Value, Tree);
 
-    if(Sentinel->Next != GuiInvalidIndex)
+    if(GuiIsValidLayoutNode(Result) && Result->Generation != Handle.Generation)
     {
-        GUI_ASSERT(Tree->NodeCount < Tree->NodeCapacity);
-
-        uint32_t FreeIndex = Sentinel->Next;
-        Result = GuiGetLayoutNode(FreeIndex, Tree);
-        GUI_ASSERT(Result);
-
-        Sentinel->Next = Result->Next;
-
-        Result->First      = GuiInvalidIndex;
-        Result->Last       = GuiInvalidIndex;
-        Result->Prev       = GuiInvalidIndex;
-        Result->Next       = GuiInvalidIndex;
-        Result->Parent     = GuiInvalidIndex;
-        Result->ChildCount = 0;
-        Result->Index      = FreeIndex;
-
-        ++Tree->NodeCount;
+        GUI_DEBUG_ASSERT(!"Stale node handle");
+        Result = 0;
     }
 
     return Result;
 }
 
 
-static void
-GuiAppendLayoutNode(uint32_t ParentIndex, uint32_t ChildIndex, gui_layout_tree *Tree)
+static gui_layout_input *
+GuiGetLayoutInput(uint32_t Index, gui_layout_tree *Tree)
 {
-    gui_layout_node *Parent = GuiGetLayoutNode(ParentIndex, Tree);
-    gui_layout_node *Child  = GuiGetLayoutNode(ChildIndex, Tree);
-
-    if(GuiIsValidLayoutNode(Parent) && GuiIsValidLayoutNode(Child))
-    {
-        Child->First  = GuiInvalidIndex;
-        Child->Last   = GuiInvalidIndex;
-        Child->Prev   = GuiInvalidIndex;
-        Child->Next   = GuiInvalidIndex;
-        Child->Parent = Parent->Index;
-
-        gui_layout_node *First = GuiGetLayoutNode(Parent->First, Tree);
-        if(!GuiIsValidLayoutNode(First))
-        {
-            Parent->First = Child->Index;
-        }
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
 
-        gui_layout_node *Last  = GuiGetLayoutNode(Parent->Last, Tree);
-        if(GuiIsValidLayoutNode(Last))
-        {
-            Last->Next  = Child->Index;
-        }
+    gui_layout_input *Result = 0;
 
-        Child->Prev         = Parent->Last;
-        Parent->Last        = Child->Index;
-        Parent->ChildCount += 1;
+    if(Index < Tree->NodeCapacity)
+    {
+        Result = Tree->Inputs + Index;
     }
-}
 
-
-//-----------------------------------------------------------------------------
-// [SECTION] NODE REFERENCES
-// [DESCRIP] Functions to insert/retrieve nodes across frames.
-// [HISTORY]
-// : - 2026-01-11 Basic Implementation
-//-----------------------------------------------------------------------------
+    return Result;
+}
 
 
-static void
-GuiInsertNodeReference(uint64_t Key, uint32_t Value, gui_layout_tree *Tree)
+static gui_layout_output *
+GuiGetLayoutOutput(uint32_t Index, gui_layout_tree *Tree)
 {
-    uint64_t Slot = Key & Tree->RefHashMask;
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
 
-    // TODO: This is a bug..
-    for(;;)
+    gui_layout_output *Result = 0;
+
+    if(Index < Tree->NodeCapacity)
     {
-        uint64_t Stored = Tree->RefKeys[Slot];
+        Result = Tree->Outputs + Index;
+    }
 
-        if(Stored == Key)
-        {
-            break;
-        }
+    return Result;
+}
 
-        // Should be some EmptyMarker.
-        if(Stored == GuiInvalidIndex)
-        {
-            Tree->RefKeys[Slot]   = Key;
-            Tree->RefValues[Slot] = Value;
 
-            break;
-        }
+static gui_layout_measure *
+GuiGetLayoutMeasure(uint32_t Index, gui_layout_tree *Tree)
+{
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    gui_layout_measure *Result = 0;
 
-        Slot = (Slot + 1) & Tree->RefHashMask;
+    if(Index < Tree->NodeCapacity)
+    {
+        Result = Tree->Measures + Index;
     }
+
+    return Result;
 }
 
 
-static uint32_t
-GuiFindNodeReference(uint64_t Key, gui_layout_tree *Tree)
+static gui_layout_state *
+GuiGetLayoutState(uint32_t Index, gui_layout_tree *Tree)
 {
-    uint32_t Result = GuiInvalidIndex;
-    uint64_t Slot   = Key & Tree->RefHashMask;
-
-    // TODO: This is a bug..
-    for(;;)
-    {
-        uint64_t Stored = Tree->RefKeys[Slot];
-        
-        // Should be some EmptyMarker.
-        if(Stored == GuiInvalidIndex)
-        {
-            break;
-        }
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
 
-        if(Stored == Key)
-        {
-            Result = Tree->RefValues[Slot];
-            break;
-        }
+    gui_layout_state *Result = 0;
 
-        Slot = (Slot + 1) & Tree->RefHashMask;
+    if(Index < Tree->NodeCapacity)
+    {
+        Result = Tree->States + Index;
     }
 
     return Result;
 }
 
 
-//-----------------------------------------------------------------------------
-// [SECTION] LAYOUT GEOMETRY
-// [DESCRIP] Basic layout geometry helpers.
-// [HISTORY]
-// : - 2026-01-11 Basic Implementation
-//-----------------------------------------------------------------------------
-
+// Returns null for nodes that do not hold a grid slot.
 
-static gui_bounding_box
-GuiGetLayoutNodeBoundingBox(gui_layout_node *Node)
+static gui_layout_grid *
+GuiGetLayoutGrid(uint32_t Index, gui_layout_tree *Tree)
 {
-    gui_bounding_box Result = { .Left = 0, .Top = 0, .Right = 0, .Bottom = 0 };
-    if(GuiIsValidLayoutNode(Node))
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    gui_layout_grid *Result = 0;
+
+    if(Index < Tree->NodeCapacity && Tree->Inputs[Index].GridIndex < Tree->GridCapacity)
     {
-        gui_point Screen = {.X = Node->OutputPosition.X, .Y = Node->OutputPosition.Y};
-        Result = (gui_bounding_box){.Left = Screen.X, .Top = Screen.Y, .Right = Screen.X + Node->OutputSize.Width, .Bottom = Screen.Y + Node->OutputSize.Height};
+        Result = Tree->Grids + Tree->Inputs[Index].GridIndex;
     }
+
     return Result;
 }
 
 
-static float
-GuiBoundingBoxSignedDistanceField(gui_point Point, gui_bounding_box BoundingBox)
+// Only called from serial code, tasks leave Moved set and the caller journals
+// their range once they are done.
+
+static void
+GuiJournalLayoutChange(uint32_t NodeIndex, gui_layout_tree *Tree)
 {
-    gui_dimensions Size   = (gui_dimensions){.Width = BoundingBox.Right - BoundingBox.Left, .Height = BoundingBox.Bottom - BoundingBox.Top};
-    gui_dimensions Half   = (gui_dimensions){.Width = Size.Width * 0.5f, .Height = Size.Height * 0.5f};
-    gui_point      Start  = (gui_point){.X = BoundingBox.Left, .Y = BoundingBox.Top};
-    gui_point      Center = (gui_point){.X = Start.X + Half.Width, .Y = Start.Y + Half.Height};
-    gui_point      Local  = (gui_point){.X = Point.X - Center.X, .Y = Point.Y - Center.Y};
+    gui_layout_state *State = Tree->States + NodeIndex;
 
-    gui_point FirstQuadrant = (gui_point){ .X = fabsf(Local.X) - Half.Width, .Y = fabsf(Local.Y) - Half.Height };
+    if(State->Dirty & Gui_LayoutDirty_Moved)
+    {
+        gui_layout_journal *Journal = Tree->Journal;
 
-    float OuterX        = (FirstQuadrant.X > 0.0f) ? FirstQuadrant.X : 0.0f;
-    float OuterY        = (FirstQuadrant.Y > 0.0f) ? FirstQuadrant.Y : 0.0f;
-    float OuterDistance = sqrtf(OuterX * OuterX + OuterY * OuterY);
-    float InnerDistance = fminf(fmaxf(FirstQuadrant.X, FirstQuadrant.Y), 0.0f);
+        State->Dirty &= ~Gui_LayoutDirty_Moved;
 
-    float Result = OuterDistance + InnerDistance;
-    return Result;
+        if(Journal && Journal->Count < Journal->Capacity)
+        {
+            Journal->Nodes[Journal->Count++] = NodeIndex;
+        }
+        else if(Journal)
+        {
+            Journal->IsComplete = GUI_FALSE;
+        }
+    }
 }
 
 
 static gui_bool
-GuiIsPointInsideOuterBox(gui_point Position, gui_layout_node *Node)
+GuiIsRelayoutBoundary(gui_layout_input *Input)
 {
-    gui_bool Result = GUI_FALSE;
-    if(GuiIsValidLayoutNode(Node))
-    {
-        gui_bounding_box Box = GuiGetLayoutNodeBoundingBox(Node);
-        float Distance = GuiBoundingBoxSignedDistanceField(Position, Box);
-        Result = Distance <= 0.0f;
-    }
+    gui_bool IsWidthFixed  = (Input->Size.Width.Type  == Gui_LayoutSizing_Fixed || Input->Size.Width.Type  == Gui_LayoutSizing_Percent);
+    gui_bool IsHeightFixed = (Input->Size.Height.Type == Gui_LayoutSizing_Fixed || Input->Size.Height.Type == Gui_LayoutSizing_Percent);
+    gui_bool Result        = IsWidthFixed && IsHeightFixed;
     return Result;
 }
 
 
-static gui_bool
-GuiIsPointInsideBorder(gui_point Position, gui_layout_node *Node)
+static void
+GuiMarkLayoutDirty(uint32_t NodeIndex, uint32_t DirtyFlags, gui_layout_tree *Tree)
 {
-    gui_bool Result = GUI_FALSE;
+    gui_layout_node *Node = GuiGetLayoutNode(NodeIndex, Tree);
 
     if(GuiIsValidLayoutNode(Node))
     {
-        gui_bounding_box Box      = GuiGetLayoutNodeBoundingBox(Node);
-        float            Distance = GuiBoundingBoxSignedDistanceField(Position, Box);
+        Tree->States[Node->Index].Dirty |= DirtyFlags;
 
-        Result = Distance >= 0.0f;
-    }
+        // Ancestors only need to know that something below them changed. Once we
+        // hit an ancestor that already knows, the rest of the chain knows as well.
 
-    return Result;
+        for(gui_layout_node *Parent = GuiGetLayoutNode(Node->Parent, Tree); GuiIsValidLayoutNode(Parent); Parent = GuiGetLayoutNode(Parent->Parent, Tree))
+        {
+            gui_layout_state *ParentState = GuiGetLayoutState(Parent->Index, Tree);
+            if(ParentState->Dirty & Gui_LayoutDirty_Descendant)
+            {
+                break;
+            }
+
+            ParentState->Dirty |= Gui_LayoutDirty_Descendant;
+
+            if(GuiIsRelayoutBoundary(GuiGetLayoutInput(Parent->Index, Tree)) && Tree->RelayoutRootCount < GUI_MAX_RELAYOUT_ROOTS)
+            {
+                Tree->RelayoutRoots[Tree->RelayoutRootCount++] = Parent->Index;
+                break;
+            }
+        }
+    }
 }
 
 
-//-----------------------------------------------------------------------------
-// [SECTION] LAYOUT RESPONSIVENESS INPUT HANDLING
-// [DESCRIP] When the user calls GuiBeginFrame we fire events at _some_ layout
-//           tree. These functions are responsible for handling those events.
-// [HISTORY]
-// : - 2026-01-11 Basic Implementation
-//-----------------------------------------------------------------------------
-
-
-static gui_bool
-GuiHandlePointerClick(gui_point Position, uint32_t ClickMask, uint32_t NodeIndex, gui_layout_tree *Tree)
+static gui_layout_node *
+GuiGetFreeLayoutNode(gui_layout_tree *Tree)
 {
-    GUI_ASSERT(Position.X >= 0.0f && Position.Y >= 0.0f);
     GUI_ASSERT(GuiIsValidLayoutTree(Tree));
 
-    if(GuiIsValidLayoutTree(Tree))
+    gui_layout_node *Sentinel = GuiGetSentinelNode(Tree);
+    gui_layout_node *Result   = 0;
+
+    // Growing moves the node arrays, the sentinel has to be fetched again.
+
+    if(Sentinel->Next == GuiInvalidIndex && Tree->Grow && Tree->Grow(Tree, Tree->NodeCapacity * 2, Tree->GrowUserData))
     {
-        gui_layout_node *Node = GuiGetLayoutNode(NodeIndex, Tree);
-        GUI_ASSERT(GuiIsValidLayoutNode(Node));
+        Sentinel = GuiGetSentinelNode(Tree);
+    }
 
-        if(GuiIsValidLayoutNode(Node))
-        {
-            if(GuiIsPointInsideOuterBox(Position, Node))
-            {
-                for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
-                {
-                    gui_bool IsHandled = GuiHandlePointerClick(Position, ClickMask, Child->Index, Tree);
-                    if(IsHandled)
-                    {
-                        return GUI_TRUE;
-                    }
-                }
+    GUI_ASSERT(Sentinel);
 
-                Node->State = Node->State | Gui_NodeState_IsClicked;
-                Node->State = Node->State | Gui_NodeState_UseFocusedStyle;
-                Node->State = Node->State | Gui_NodeState_HasCapturedPointer;
+    if(Sentinel->Next != GuiInvalidIndex)
+    {
+        GUI_ASSERT(Tree->NodeCount < Tree->NodeCapacity);
 
-                Tree->CapturedNodeIndex = NodeIndex;
+        uint32_t FreeIndex = Sentinel->Next;
+        Result = GuiGetLayoutNode(FreeIndex, Tree);
+        GUI_ASSERT(Result);
 
-                return GUI_TRUE;
-            }
-        }
+        Sentinel->Next = Result->Next;
+
+        Result->First      = GuiInvalidIndex;
+        Result->Last       = GuiInvalidIndex;
+        Result->Prev       = GuiInvalidIndex;
+        Result->Next       = GuiInvalidIndex;
+        Result->Parent     = GuiInvalidIndex;
+        Result->ChildCount = 0;
+        Result->Index      = FreeIndex;
+
+        Tree->Inputs[FreeIndex]   = (gui_layout_input){.GridIndex = GuiInvalidIndex};
+        Tree->Outputs[FreeIndex]  = (gui_layout_output){0};
+        Tree->Measures[FreeIndex] = (gui_layout_measure){0};
+        Tree->States[FreeIndex]   = (gui_layout_state){.Dirty = Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place};
+        Tree->Wraps[FreeIndex]    = (gui_layout_wrap){0};
+        Tree->Retains[FreeIndex]  = (gui_layout_retain){.Prev = GuiInvalidIndex, .Next = GuiInvalidIndex};
+
+        ++Tree->NodeCount;
     }
 
-    return GUI_FALSE;
+    return Result;
 }
 
 
-static gui_bool
-GuiHandlePointerRelease(gui_point Position, uint32_t ReleaseMask, uint32_t NodeIndex, gui_layout_tree *Tree)
+// An empty grid pool asks the growth callback like an empty free list does. A grid
+// node left without a slot is laid out as a vertical list until it gets one.
+
+static gui_layout_grid *
+GuiAcquireLayoutGrid(uint32_t NodeIndex, gui_layout_tree *Tree)
 {
-    GUI_ASSERT(Position.X >= 0.0f && Position.Y >= 0.0f);
-    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+    GUI_ASSERT(!GuiGetLayoutGrid(NodeIndex, Tree));
 
-    if(GuiIsValidLayoutTree(Tree))
-    {
-        gui_layout_node *Node = GuiGetLayoutNode(NodeIndex, Tree);
-        GUI_ASSERT(GuiIsValidLayoutNode(Node));
+    gui_layout_grid *Result = 0;
 
-        for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
-        {
-            if(GuiHandlePointerRelease(Position, ReleaseMask, Child->Index, Tree))
-            {
-                return GUI_TRUE;
-            }
-        }
+    if(Tree->FreeGrid == GuiInvalidIndex && Tree->Grow)
+    {
+        Tree->Grow(Tree, Tree->NodeCapacity * 2, Tree->GrowUserData);
+    }
 
-        if(Node->State & Gui_NodeState_HasCapturedPointer)
-        {
-            Node->State = Node->State & ~(Gui_NodeState_HasCapturedPointer | Gui_NodeState_UseFocusedStyle);
+    if(Tree->FreeGrid != GuiInvalidIndex)
+    {
+        uint32_t Slot = Tree->FreeGrid;
 
-            Tree->CapturedNodeIndex = GuiInvalidIndex;
+        Result         = Tree->Grids + Slot;
+        Tree->FreeGrid = Result->NextFree;
 
-            return GUI_TRUE;
-        }
+        *Result                           = (gui_layout_grid){.NextFree = GuiInvalidIndex};
+        Tree->Inputs[NodeIndex].GridIndex = Slot;
     }
 
-    return GUI_FALSE;
+    return Result;
 }
 
 
-static gui_bool
-GuiHandlePointerHover(gui_point Position, uint32_t NodeIndex, gui_layout_tree *Tree)
+static void
+GuiReleaseLayoutGrid(uint32_t NodeIndex, gui_layout_tree *Tree)
 {
-    GUI_ASSERT(Position.X >= 0.0f && Position.Y >= 0.0f);
+    gui_layout_grid *Grid = GuiGetLayoutGrid(NodeIndex, Tree);
 
-    if(GuiIsValidLayoutTree(Tree))
+    if(Grid)
     {
-        gui_layout_node *Node = GuiGetLayoutNode(NodeIndex, Tree);
-        GUI_ASSERT(GuiIsValidLayoutNode(Node));
+        Grid->NextFree = Tree->FreeGrid;
+        Tree->FreeGrid = Tree->Inputs[NodeIndex].GridIndex;
 
-        if(GuiIsPointInsideOuterBox(Position, Node))
-        {
-            for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
-            {
-                gui_bool IsHandled = GuiHandlePointerHover(Position, Child->Index, Tree);
-                if (IsHandled)
-                {
-                    return GUI_TRUE;
-                }
-            }
+        Tree->Inputs[NodeIndex].GridIndex = GuiInvalidIndex;
+    }
+}
 
-            Node->State = Node->State | Gui_NodeState_UseHoveredStyle;
 
-            return GUI_TRUE;
-        }
+// A child list is closed once all of its children were appended this frame,
+// children left over from last frame are cut off its end.
+
+static void
+GuiCloseChildList(gui_layout_node *Node, gui_layout_tree *Tree)
+{
+    gui_layout_node *Last      = GuiGetLayoutNode(Node->Last, Tree);
+    gui_bool         IsChanged = (Node->ChildCount != Node->LastChildCount);
+
+    if(GuiIsValidLayoutNode(Last) && Last->Next != GuiInvalidIndex)
+    {
+        Last->Next = GuiInvalidIndex;
+        IsChanged  = GUI_TRUE;
+    }
+    else if(!GuiIsValidLayoutNode(Last) && Node->First != GuiInvalidIndex)
+    {
+        Node->First = GuiInvalidIndex;
+        IsChanged   = GUI_TRUE;
     }
 
-    return GUI_FALSE;
+    if(IsChanged)
+    {
+        GuiMarkLayoutDirty(Node->Index, Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place, Tree);
+        Tree->Wraps[Node->Index].Stamp += 1;
+        Tree->IsTopologyDirty           = GUI_TRUE;
+    }
+
+    Node->LastChildCount = Node->ChildCount;
 }
 
 
+// Links are kept between frames. While a parent is being built, Last is the last
+// child appended this frame, and the child expected next is the one that followed
+// it last frame. A child appended where it already is does not write anything,
+// anything else relinks it and changes the shape of the tree. Appending a child
+// closes the child list of the sibling before it.
+
 static void
-GuiHandlePointerMove(float DeltaX, float DeltaY, gui_layout_tree *Tree)
+GuiAppendLayoutNode(uint32_t ParentIndex, uint32_t ChildIndex, gui_layout_tree *Tree)
 {
-    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+    gui_layout_node *Parent = GuiGetLayoutNode(ParentIndex, Tree);
+    gui_layout_node *Child  = GuiGetLayoutNode(ChildIndex, Tree);
 
-    if(GuiIsValidLayoutTree(Tree))
+    if(GuiIsValidLayoutNode(Parent) && GuiIsValidLayoutNode(Child))
     {
-        gui_layout_node *CapturedNode = GuiGetLayoutNode(Tree->CapturedNodeIndex, Tree);
-        if(GuiIsValidLayoutNode(CapturedNode))
+        gui_layout_node *Last     = GuiGetLayoutNode(Parent->Last, Tree);
+        uint32_t         Expected = GuiIsValidLayoutNode(Last) ? Last->Next : Parent->First;
+
+        if(GuiIsValidLayoutNode(Last))
+        {
+            GuiCloseChildList(Last, Tree);
+        }
+
+        if(Expected != Child->Index || Child->Parent != Parent->Index || Child->Prev != Parent->Last)
         {
-            if(CapturedNode->Flags & Gui_NodeFlags_IsDraggable)
+            if(GuiIsValidLayoutNode(Last))
             {
-                CapturedNode->OutputPosition.X += DeltaX;
-                CapturedNode->OutputPosition.Y += DeltaY;
+                Last->Next = Child->Index;
             }
+            else
+            {
+                Parent->First = Child->Index;
+            }
+
+            Child->Parent = Parent->Index;
+            Child->Prev   = Parent->Last;
+
+            GuiMarkLayoutDirty(Child->Index, Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place, Tree);
+            Tree->Wraps[Parent->Index].Stamp += 1;
+            Tree->IsTopologyDirty             = GUI_TRUE;
         }
+
+        Parent->Last        = Child->Index;
+        Parent->ChildCount += 1;
     }
 }
 
 
-//-----------------------------------------------------------------------------
-// [SECTION] LAYOUT COMPUTATION CORE
-// [DESCRIP] Convergence based layout algorithm implementation & helpers
-// [HISTORY]
-// : - 2026-01-11 Basic Implementation
-//-----------------------------------------------------------------------------
-
+// Every pass walks the tree through a flat pre-order array instead of chasing
+// First/Next links. A subtree is a contiguous range of that array, the size stored
+// next to each entry lets a forward walk skip it. A reverse walk visits children
+// before their parent. The array is only rebuilt when the shape of the tree changes.
 
-static float
-GuiGetAlignmentOffset(Gui_Alignment AlignmentType, float FreeSpace)
+static void
+GuiUpdateDepthFirstOrder(gui_layout_tree *Tree)
 {
-    float Result = 0.0f;
+    if(!Tree->IsTopologyDirty)
+    {
+        return;
+    }
 
-    if(FreeSpace > 0.0f)
+    uint32_t         Count = 0;
+    gui_layout_node *Root  = GuiGetLayoutNode(Tree->RootIndex, Tree);
+    gui_layout_node *Node  = Root;
+
+    while(GuiIsValidLayoutNode(Node))
     {
-        switch(AlignmentType)
-        {
+        GUI_ASSERT(Count < Tree->NodeCapacity);
 
-        case Gui_Alignment_None:
-        case Gui_Alignment_Start:
-        {
-            // No-Op
-        } break;
+        Node->DepthFirstIndex   = Count;
+        Tree->DepthFirst[Count] = Node->Index;
+        ++Count;
 
-        case Gui_Alignment_Center:
+        gui_layout_node *First = GuiGetLayoutNode(Node->First, Tree);
+        if(GuiIsValidLayoutNode(First))
         {
-            Result = 0.5f * FreeSpace;
-        } break;
+            Node = First;
+            continue;
+        }
 
-        case Gui_Alignment_End:
+        // Close every subtree we are leaving on the way back up.
+
+        while(GuiIsValidLayoutNode(Node))
         {
-            // TODO: implement end alignment
-        } break;
+            Tree->DepthFirstSize[Node->DepthFirstIndex] = Count - Node->DepthFirstIndex;
+
+            if(Node == Root)
+            {
+                Node = 0;
+                break;
+            }
+
+            gui_layout_node *Next = GuiGetLayoutNode(Node->Next, Tree);
+            if(GuiIsValidLayoutNode(Next))
+            {
+                Node = Next;
+                break;
+            }
 
+            Node = GuiGetLayoutNode(Node->Parent, Tree);
         }
     }
 
-    return Result;
+    Tree->DepthFirstCount = Count;
+    Tree->IsTopologyDirty = GUI_FALSE;
+    Tree->AreTasksDirty   = GUI_TRUE;
 }
 
 
-static float
-GuiComputeNodeSize(gui_sizing Sizing, float ParentSize)
+static gui_layout_node *
+GuiGetDepthFirstNode(uint32_t DepthFirstIndex, gui_layout_tree *Tree)
 {
-    float Result = 0.0f;
+    GUI_ASSERT(DepthFirstIndex < Tree->DepthFirstCount);
 
-    switch(Sizing.Type)
-    {
+    gui_layout_node *Result = GuiGetLayoutNode(Tree->DepthFirst[DepthFirstIndex], Tree);
+    return Result;
+}
 
-    case Gui_LayoutSizing_None:
-    {
-    } break;
 
-    case Gui_LayoutSizing_Fixed:
-    {
-        Result = Sizing.Value;
-    } break;
+static uint64_t
+GuiMixLayoutHash(uint64_t Hash, uint64_t Value)
+{
+    uint64_t Result = (Hash ^ Value) * 0x9E3779B97F4A7C15ull;
+    Result ^= Result >> 29;
+    return Result;
+}
 
-    case Gui_LayoutSizing_Percent:
-    {
-        GUI_ASSERT(Sizing.Value >= 0.0f && Sizing.Value <= 100.0f);
-        Result = (Sizing.Value / 100.0f) * ParentSize;
-    } break;
 
-    case Gui_LayoutSizing_Fit:
-    {
-        // TODO: implement fit
-    } break;
+static uint64_t
+GuiMixLayoutFloat(uint64_t Hash, float Value)
+{
+    union { float Float; uint32_t Bits; } Cast = { .Float = Value };
+
+    uint64_t Result = GuiMixLayoutHash(Hash, Cast.Bits);
+    return Result;
+}
 
-    }
 
+static uint64_t
+GuiMixLayoutSize(uint64_t Hash, gui_size Size)
+{
+    uint64_t Result = Hash;
+    Result = GuiMixLayoutHash (Result, Size.Width.Type);
+    Result = GuiMixLayoutFloat(Result, Size.Width.Value);
+    Result = GuiMixLayoutHash (Result, Size.Height.Type);
+    Result = GuiMixLayoutFloat(Result, Size.Height.Value);
     return Result;
 }
 
 
-static void
-GuiComputeLayout(gui_layout_node *Node, gui_layout_tree *Tree, gui_dimensions ParentBounds, gui_resource_table *ResourceTable, gui_bool *Changed)
+// Everything that can change where the node's children end up relative to it.
+// Children fold their own hash into their parent's during the measure pass.
+
+static uint64_t
+GuiHashLayoutInput(gui_layout_input *Input, uint32_t ChildCount)
 {
-    GUI_ASSERT(GuiIsValidLayoutNode(Node));
-    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+    uint64_t Result = GuiMixLayoutHash(0xCBF29CE484222325ull, ChildCount);
+
+    Result = GuiMixLayoutSize (Result, Input->Size);
+    Result = GuiMixLayoutSize (Result, Input->MinSize);
+    Result = GuiMixLayoutSize (Result, Input->MaxSize);
+    Result = GuiMixLayoutHash (Result, Input->XAlign);
+    Result = GuiMixLayoutHash (Result, Input->YAlign);
+    Result = GuiMixLayoutHash (Result, Input->Direction);
+    Result = GuiMixLayoutFloat(Result, Input->Padding.Left);
+    Result = GuiMixLayoutFloat(Result, Input->Padding.Top);
+    Result = GuiMixLayoutFloat(Result, Input->Padding.Right);
+    Result = GuiMixLayoutFloat(Result, Input->Padding.Bottom);
+    Result = GuiMixLayoutFloat(Result, Input->Spacing);
+    Result = GuiMixLayoutFloat(Result, Input->Grow);
+    Result = GuiMixLayoutFloat(Result, Input->Shrink);
+    Result = GuiMixLayoutHash (Result, Input->Wrap);
+    Result = GuiMixLayoutFloat(Result, Input->AnimatedOffset.X);
+    Result = GuiMixLayoutFloat(Result, Input->AnimatedOffset.Y);
+    Result = GuiMixLayoutFloat(Result, Input->ContentOffset.X);
+    Result = GuiMixLayoutFloat(Result, Input->ContentOffset.Y);
 
-    Node->OutputChildSize = (gui_dimensions){ .Width = 0.0f, .Height = 0.0f };
-    gui_dimensions LastSize = Node->OutputSize;
+    return Result;
+}
 
-    float Width     = GuiComputeNodeSize(Node->Size.Width    , ParentBounds.Width);
-    float MinWidth  = GuiComputeNodeSize(Node->MinSize.Width , ParentBounds.Width);
-    float MaxWidth  = GuiComputeNodeSize(Node->MaxSize.Width , ParentBounds.Width);
-    float Height    = GuiComputeNodeSize(Node->Size.Height   , ParentBounds.Height);
-    float MinHeight = GuiComputeNodeSize(Node->MinSize.Height, ParentBounds.Height);
-    float MaxHeight = GuiComputeNodeSize(Node->MaxSize.Height, ParentBounds.Height);
 
-    Node->OutputSize = (gui_dimensions){ .Width = fmaxf(MinWidth, fminf(Width, MaxWidth)), .Height = fmaxf(MinHeight, fminf(Height, MaxHeight)) };
+static uint64_t
+GuiHashGridTracks(uint64_t Hash, gui_grid_tracks *Tracks)
+{
+    uint64_t Result = GuiMixLayoutHash(Hash, Tracks->ColumnCount);
+    Result = GuiMixLayoutHash(Result, Tracks->RowCount);
 
-    if((Node->OutputSize.Width != LastSize.Width) || (Node->OutputSize.Height != LastSize.Height))
+    for(uint32_t Idx = 0; Idx < Tracks->ColumnCount; ++Idx)
     {
-        if(Changed) *Changed = GUI_TRUE;
+        Result = GuiMixLayoutHash (Result, Tracks->Columns[Idx].Type);
+        Result = GuiMixLayoutFloat(Result, Tracks->Columns[Idx].Value);
     }
 
-    gui_dimensions ContentBounds = (gui_dimensions){.Width = Node->OutputSize.Width - (Node->Padding.Left + Node->Padding.Right), .Height = Node->OutputSize.Height - (Node->Padding.Top + Node->Padding.Bottom)};
-
-    if(Node->ChildCount > 0)
+    for(uint32_t Idx = 0; Idx < Tracks->RowCount; ++Idx)
     {
-        float Spacing = Node->Spacing * (float)(Node->ChildCount - 1);
-        if(Node->Direction == Gui_LayoutDirection_Horizontal)
-        {
-            ContentBounds.Width -= Spacing;
-        }
-        else if(Node->Direction == Gui_LayoutDirection_Vertical)
-        {
-            ContentBounds.Height -= Spacing;
-        }
+        Result = GuiMixLayoutHash (Result, Tracks->Rows[Idx].Type);
+        Result = GuiMixLayoutFloat(Result, Tracks->Rows[Idx].Value);
     }
 
-    GUI_ASSERT(ContentBounds.Width >= 0.0f && ContentBounds.Height >= 0.0f);
+    return Result;
+}
+
+
+// Children must be measured first, their hash is folded into their parent's.
+
+static uint64_t
+GuiHashLayoutNode(gui_layout_node *Node, gui_layout_tree *Tree)
+{
+    gui_layout_input *Input  = GuiGetLayoutInput(Node->Index, Tree);
+    uint64_t          Result = GuiHashLayoutInput(Input, Node->ChildCount);
 
     for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
     {
-        GuiComputeLayout(Child, Tree, ContentBounds, ResourceTable, Changed);
+        Result = GuiMixLayoutHash(Result, Tree->Measures[Child->Index].SubtreeHash);
+    }
 
-        Node->OutputChildSize.Width  += Child->OutputSize.Width;
-        Node->OutputChildSize.Height += Child->OutputSize.Height;
+    gui_layout_grid *Grid = GuiGetLayoutGrid(Node->Index, Tree);
+    if(Grid)
+    {
+        Result = GuiHashGridTracks(Result, &Grid->Tracks);
     }
+
+    return Result;
 }
 
 
-static void
-GuiPlaceLayout(gui_layout_node *Node, gui_layout_tree *Tree, gui_resource_table *ResourceTable)
+static gui_bool
+GuiIsSameSizing(gui_sizing A, gui_sizing B)
 {
-    gui_point Cursor   = (gui_point){ .X = Node->OutputPosition.X + Node->Padding.Left, .Y = Node->OutputPosition.Y + Node->Padding.Top };
-    gui_bool  IsXMajor = (Node->Direction == Gui_LayoutDirection_Horizontal);
+    gui_bool Result = (A.Type == B.Type) && (A.Value == B.Value);
+    return Result;
+}
 
-    float MajorSize = IsXMajor ? Node->OutputSize.Width - (Node->Padding.Left + Node->Padding.Right) : Node->OutputSize.Height - (Node->Padding.Top + Node->Padding.Bottom);
-    float MinorSize = IsXMajor ? Node->OutputSize.Height - (Node->Padding.Top + Node->Padding.Bottom) : Node->OutputSize.Width - (Node->Padding.Left + Node->Padding.Right);
 
-    Gui_Alignment MajorAlignment    = IsXMajor ? Node->XAlign : Node->YAlign;
-    float         MajorChildrenSize = IsXMajor ? Node->OutputChildSize.Width : Node->OutputChildSize.Height;
-    float         MajorOffset       = GuiGetAlignmentOffset(MajorAlignment, MajorSize - MajorChildrenSize);
+static gui_bool
+GuiIsSameSize(gui_size A, gui_size B)
+{
+    gui_bool Result = GuiIsSameSizing(A.Width, B.Width) && GuiIsSameSizing(A.Height, B.Height);
+    return Result;
+}
 
-    if(IsXMajor)
+
+static gui_bool
+GuiIsSameLayoutInput(gui_layout_input *Input, gui_layout_properties *Properties)
+{
+    gui_bool Result = GuiIsSameSize(Input->Size, Properties->Size)       &&
+                      GuiIsSameSize(Input->MinSize, Properties->MinSize) &&
+                      GuiIsSameSize(Input->MaxSize, Properties->MaxSize) &&
+                      Input->Direction      == Properties->Direction      &&
+                      Input->XAlign         == Properties->XAlign         &&
+                      Input->YAlign         == Properties->YAlign         &&
+                      Input->Padding.Left   == Properties->Padding.Left   &&
+                      Input->Padding.Top    == Properties->Padding.Top    &&
+                      Input->Padding.Right  == Properties->Padding.Right  &&
+                      Input->Padding.Bottom == Properties->Padding.Bottom &&
+                      Input->Spacing        == Properties->Spacing        &&
+                      Input->Grow           == Properties->Grow           &&
+                      Input->Shrink         == Properties->Shrink         &&
+                      Input->Wrap           == Properties->Wrap;
+    return Result;
+}
+
+
+static gui_bool
+GuiIsSameGridTracks(gui_grid_tracks *A, gui_grid_tracks *B)
+{
+    gui_bool Result = (A->ColumnCount == B->ColumnCount) && (A->RowCount == B->RowCount);
+
+    for(uint32_t Idx = 0; Result && Idx < A->ColumnCount; ++Idx)
     {
-        Cursor.X += MajorOffset;
+        Result = GuiIsSameSizing(A->Columns[Idx], B->Columns[Idx]);
     }
-    else
+
+    for(uint32_t Idx = 0; Result && Idx < A->RowCount; ++Idx)
     {
-        Cursor.Y += MajorOffset;
+        Result = GuiIsSameSizing(A->Rows[Idx], B->Rows[Idx]);
     }
 
-    for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
-    {
-        Child->OutputPosition = Cursor;
-        Gui_Alignment MinorAlign = IsXMajor ? Node->YAlign : Node->XAlign;
-        float MinorOffset = GuiGetAlignmentOffset(MinorAlign, IsXMajor ? (MinorSize - Child->OutputSize.Height) : (MinorSize - Child->OutputSize.Width));
+    return Result;
+}
 
-        if(IsXMajor)
-        {
-            Child->OutputPosition.Y += MinorOffset;
-            Cursor.X                += Child->OutputSize.Width + Node->Spacing;
-        }
-        else
-        {
-            Child->OutputPosition.X += MinorOffset;
-            Cursor.Y                += Child->OutputSize.Height + Node->Spacing;
-        }
 
-        Child->OutputPosition.X += Child->AnimatedOffset.X;
-        Child->OutputPosition.Y += Child->AnimatedOffset.Y;
+// A grid without column tracks is a single column that fills the content box.
 
-        GuiPlaceLayout(Child, Tree, ResourceTable);
+static gui_grid_tracks
+GuiGetGridTracks(gui_grid_tracks *Tracks)
+{
+    gui_grid_tracks Result = *Tracks;
+
+    Result.ColumnCount = (Result.ColumnCount < GUI_MAX_GRID_TRACKS) ? Result.ColumnCount : GUI_MAX_GRID_TRACKS;
+    Result.RowCount    = (Result.RowCount    < GUI_MAX_GRID_TRACKS) ? Result.RowCount    : GUI_MAX_GRID_TRACKS;
+
+    if(Result.ColumnCount == 0)
+    {
+        Result.Columns[0]  = (gui_sizing){ .Value = 1.0f, .Type = Gui_LayoutSizing_Fraction };
+        Result.ColumnCount = 1;
     }
+
+    return Result;
 }
 
+
 //-----------------------------------------------------------------------------
-// [SECTION] PUBLIC LAYOUT API
-// [DESCRIP] ...
+// [SECTION] NODE REFERENCES
+// [DESCRIP] Functions to insert/retrieve nodes across frames.
 // [HISTORY]
+// : - 2026-10-17 Swiss table sized apart from the nodes, at most half full, probed 16 tags at a time
+// : - 2026-10-17 Probes are bounded, a full map no longer hangs lookups
+// : - 2026-10-17 Freeing a node bumps its slot generation
+// : - 2026-10-17 Reference removal, node touch, free and sweep
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
 
 
-GUI_API gui_memory_footprint
-GuiGetLayoutTreeFootprint(uint32_t NodeCount)
-{
-    uint64_t TreeEnd       = sizeof(gui_layout_tree);
+// The map is a Swiss table. Slots come in groups of 16 and each slot has a tag
+// byte: the low 7 bits of its key's hash, or Empty, or Deleted. A lookup matches
+// its tag against a whole group with one compare and only reads the keys whose
+// tag matched, so it usually costs a single group. Groups are probed in triangular
+// order, which visits each of them once. The table has at least twice as many
+// slots as the tree has nodes. Deleted slots are reused by inserts, and the table
+// is rebuilt from the live nodes when too many of them pile up.
 
-    uint64_t NodesStart    = GUI_ALIGN_POW2(TreeEnd, GUI_ALIGN_OF(gui_layout_node));
-    uint64_t NodesEnd      = NodesStart + ((NodeCount + 1) * sizeof(gui_layout_node));
+#define GUI_REFERENCE_GROUP_WIDTH 16
 
-    uint64_t PaintStart    = GUI_ALIGN_POW2(NodesEnd, GUI_ALIGN_OF(gui_paint_properties));
-    uint64_t PaintEnd      = PaintStart + (NodeCount * sizeof(gui_paint_properties));
+static const uint8_t GuiReferenceEmpty   = 0x80;
+static const uint8_t GuiReferenceDeleted = 0xFE;
+
+
+// Grids are containers, a tree rarely has more than one for every eight nodes. The
+// tree grows when it runs out of grid slots, like it does when it runs out of nodes.
+
+static uint32_t
+GuiGetGridCapacity(uint32_t NodeCount)
+{
+    uint32_t Result = (NodeCount / 8) + 1;
+    return Result;
+}
+
+
+static uint32_t
+GuiGetReferenceCapacity(uint32_t NodeCount)
+{
+    uint32_t Result = GUI_REFERENCE_GROUP_WIDTH;
+
+    while(Result < 2ull * NodeCount)
+    {
+        Result <<= 1;
+    }
+
+    return Result;
+}
+
+
+static uint64_t
+GuiHashNodeReference(uint64_t Key)
+{
+    uint64_t Result = Key;
+
+    Result ^= Result >> 33;
+    Result *= 0xFF51AFD7ED558CCDull;
+    Result ^= Result >> 33;
+
+    return Result;
+}
+
+
+// Returns one bit per slot of the group whose tag equals Tag.
+
+static uint32_t
+GuiMatchReferenceGroup(uint8_t *Group, uint8_t Tag)
+{
+#if GUI_SSE2
+    __m128i  Tags   = _mm_loadu_si128((__m128i *)Group);
+    uint32_t Result = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(Tags, _mm_set1_epi8((char)Tag)));
+#else
+    uint32_t Result = 0;
+
+    for(uint32_t Idx = 0; Idx < GUI_REFERENCE_GROUP_WIDTH; ++Idx)
+    {
+        Result |= (uint32_t)(Group[Idx] == Tag) << Idx;
+    }
+#endif
+
+    return Result;
+}
+
+
+// Returns the slot holding Key, and how many groups were read in ProbeCount. Does not
+// touch the stats: inserts and removals use it too, and only lookups are counted.
+
+static uint64_t
+GuiFindNodeReferenceSlot(uint64_t Key, uint64_t *ProbeCount, gui_layout_tree *Tree)
+{
+    uint64_t Result = GuiInvalidIndex;
+    uint64_t Hash   = GuiHashNodeReference(Key);
+    uint8_t  Tag    = (uint8_t)(Hash & 0x7F);
+    uint64_t Group  = (Hash >> 7) & Tree->RefGroupMask;
+    uint64_t Probe  = 0;
+
+    while(Probe <= Tree->RefGroupMask)
+    {
+        uint8_t *Tags  = Tree->RefTags + (Group * GUI_REFERENCE_GROUP_WIDTH);
+        uint32_t Match = GuiMatchReferenceGroup(Tags, Tag);
+
+        Probe += 1;
+
+        while(Match)
+        {
+            uint64_t Slot = (Group * GUI_REFERENCE_GROUP_WIDTH) + GUI_FIND_FIRST_BIT(Match);
+
+            if(Tree->RefKeys[Slot] == Key)
+            {
+                Result = Slot;
+                break;
+            }
+
+            Match &= Match - 1;
+        }
+
+        // An empty slot means no insert ever moved past this group.
+
+        if(Result != GuiInvalidIndex || GuiMatchReferenceGroup(Tags, GuiReferenceEmpty))
+        {
+            break;
+        }
+
+        Group = (Group + Probe) & Tree->RefGroupMask;
+    }
+
+    *ProbeCount = Probe;
+
+    return Result;
+}
+
+
+static void
+GuiInsertNodeReference(uint64_t Key, uint32_t Value, gui_layout_tree *Tree)
+{
+    uint64_t ProbeCount = 0;
+    uint64_t Existing   = GuiFindNodeReferenceSlot(Key, &ProbeCount, Tree);
+    if(Existing != GuiInvalidIndex)
+    {
+        Tree->RefValues[Existing] = Value;
+        return;
+    }
+
+    uint64_t Hash  = GuiHashNodeReference(Key);
+    uint8_t  Tag   = (uint8_t)(Hash & 0x7F);
+    uint64_t Group = (Hash >> 7) & Tree->RefGroupMask;
+
+    for(uint64_t Probe = 1; Probe <= Tree->RefGroupMask + 1; ++Probe)
+    {
+        uint8_t *Tags = Tree->RefTags + (Group * GUI_REFERENCE_GROUP_WIDTH);
+        uint32_t Free = GuiMatchReferenceGroup(Tags, GuiReferenceEmpty) | GuiMatchReferenceGroup(Tags, GuiReferenceDeleted);
+
+        if(Free)
+        {
+            uint64_t Slot = (Group * GUI_REFERENCE_GROUP_WIDTH) + GUI_FIND_FIRST_BIT(Free);
+
+            if(Tree->RefTags[Slot] == GuiReferenceDeleted)
+            {
+                Tree->RefDeletedCount -= 1;
+            }
+
+            Tree->RefTags[Slot]   = Tag;
+            Tree->RefKeys[Slot]   = Key;
+            Tree->RefValues[Slot] = Value;
+            break;
+        }
+
+        Group = (Group + Probe) & Tree->RefGroupMask;
+    }
+}
+
+
+static uint32_t
+GuiFindNodeReference(uint64_t Key, gui_layout_tree *Tree)
+{
+    uint64_t ProbeCount = 0;
+    uint64_t Slot       = GuiFindNodeReferenceSlot(Key, &ProbeCount, Tree);
+    uint32_t Result     = (Slot != GuiInvalidIndex) ? Tree->RefValues[Slot] : GuiInvalidIndex;
+
+    Tree->Stats.ReferenceLookupCount += 1;
+    Tree->Stats.ReferenceProbeCount  += ProbeCount;
+
+    if(ProbeCount > Tree->Stats.ReferenceMaxProbe)
+    {
+        Tree->Stats.ReferenceMaxProbe = ProbeCount;
+    }
+
+    return Result;
+}
+
+
+// A group that still has an empty slot never sent a lookup further, so the slot
+// can become empty again. Otherwise it is marked deleted to keep the chain intact.
+
+static void
+GuiRemoveNodeReference(uint64_t Key, gui_layout_tree *Tree)
+{
+    uint64_t ProbeCount = 0;
+    uint64_t Slot       = GuiFindNodeReferenceSlot(Key, &ProbeCount, Tree);
+
+    if(Slot == GuiInvalidIndex)
+    {
+        return;
+    }
+
+    uint8_t *Tags = Tree->RefTags + (Slot & ~(uint64_t)(GUI_REFERENCE_GROUP_WIDTH - 1));
+
+    if(GuiMatchReferenceGroup(Tags, GuiReferenceEmpty))
+    {
+        Tree->RefTags[Slot] = GuiReferenceEmpty;
+    }
+    else
+    {
+        Tree->RefTags[Slot]    = GuiReferenceDeleted;
+        Tree->RefDeletedCount += 1;
+    }
+}
+
+
+// Every live node keeps its key in its retain entry, so the map can be rebuilt
+// from the nodes alone. Used when the tree grows and to clear deleted slots.
+
+static void
+GuiRebuildNodeReferences(gui_layout_tree *Tree)
+{
+    uint64_t SlotCount = (Tree->RefGroupMask + 1) * GUI_REFERENCE_GROUP_WIDTH;
+
+    for(uint64_t Slot = 0; Slot < SlotCount; ++Slot)
+    {
+        Tree->RefTags[Slot] = GuiReferenceEmpty;
+    }
+
+    Tree->RefDeletedCount = 0;
+
+    for(uint32_t Idx = 0; Idx < Tree->NodeCapacity; ++Idx)
+    {
+        if(Tree->Nodes[Idx].Index != GuiInvalidIndex)
+        {
+            GuiInsertNodeReference(Tree->Retains[Idx].Key, Idx, Tree);
+        }
+    }
+
+    Tree->Stats.ReferenceRebuildCount += 1;
+}
+
+
+static void
+GuiTouchLayoutNode(uint32_t NodeIndex, gui_layout_tree *Tree)
+{
+    gui_layout_retain *Retain = Tree->Retains + NodeIndex;
+
+    if(Retain->Stamp == Tree->FrameStamp)
+    {
+        return;
+    }
+
+    if(Retain->Stamp == Tree->FrameStamp - 1)
+    {
+        if(Retain->Prev != GuiInvalidIndex)
+        {
+            Tree->Retains[Retain->Prev].Next = Retain->Next;
+        }
+        else
+        {
+            Tree->StaleFirst = Retain->Next;
+        }
+
+        if(Retain->Next != GuiInvalidIndex)
+        {
+            Tree->Retains[Retain->Next].Prev = Retain->Prev;
+        }
+    }
+
+    if(Tree->TouchedFirst != GuiInvalidIndex)
+    {
+        Tree->Retains[Tree->TouchedFirst].Prev = NodeIndex;
+    }
+
+    Retain->Stamp      = Tree->FrameStamp;
+    Retain->Prev       = GuiInvalidIndex;
+    Retain->Next       = Tree->TouchedFirst;
+    Tree->TouchedFirst = NodeIndex;
+}
+
+
+// A freed node is not reachable anymore: its parent was either freed too or was
+// declared again, which cut it out of the child list.
+
+static void
+GuiFreeLayoutNode(uint32_t NodeIndex, gui_layout_tree *Tree)
+{
+    gui_layout_node *Sentinel = GuiGetSentinelNode(Tree);
+    gui_layout_node *Node     = GuiGetLayoutNode(NodeIndex, Tree);
+
+    GuiRemoveNodeReference(Tree->Retains[NodeIndex].Key, Tree);
+    GuiReleaseLayoutGrid(NodeIndex, Tree);
+
+    for(uint32_t Idx = 0; Idx < Tree->AnimationCount; ++Idx)
+    {
+        if(Tree->Animations[Idx].NodeTarget == NodeIndex)
+        {
+            Tree->Animations[Idx--] = Tree->Animations[--Tree->AnimationCount];
+        }
+    }
+
+    if(Tree->CapturedNodeIndex == NodeIndex)
+    {
+        Tree->CapturedNodeIndex = GuiInvalidIndex;
+    }
+
+    if(Tree->RootIndex == NodeIndex)
+    {
+        Tree->RootIndex       = GuiInvalidIndex;
+        Tree->IsTopologyDirty = GUI_TRUE;
+    }
+
+    Tree->PaintBuffer[NodeIndex] = (gui_paint_properties){0};
+    Tree->Retains[NodeIndex]     = (gui_layout_retain){.Prev = GuiInvalidIndex, .Next = GuiInvalidIndex};
+
+    Node->Index       = GuiInvalidIndex;
+    Node->Generation += 1;
+    Node->Next        = Sentinel->Next;
+    Sentinel->Next    = NodeIndex;
+
+    --Tree->NodeCount;
+    ++Tree->Stats.FreedCount;
+}
+
+
+static void
+GuiSweepLayoutNodes(gui_layout_tree *Tree)
+{
+    uint32_t NodeIndex = Tree->StaleFirst;
+
+    while(NodeIndex != GuiInvalidIndex)
+    {
+        uint32_t Next = Tree->Retains[NodeIndex].Next;
+        GuiFreeLayoutNode(NodeIndex, Tree);
+        NodeIndex = Next;
+    }
+
+    if(Tree->RefDeletedCount > (Tree->RefGroupMask + 1) * GUI_REFERENCE_GROUP_WIDTH / 4)
+    {
+        GuiRebuildNodeReferences(Tree);
+    }
+
+    Tree->StaleFirst    = Tree->TouchedFirst;
+    Tree->TouchedFirst  = GuiInvalidIndex;
+    Tree->FrameStamp   += 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// [SECTION] LAYOUT GEOMETRY
+// [DESCRIP] Basic layout geometry helpers.
+// [HISTORY]
+// : - 2026-01-11 Basic Implementation
+//-----------------------------------------------------------------------------
+
+
+static gui_bounding_box
+GuiGetLayoutNodeBoundingBox(gui_layout_output *Output)
+{
+    gui_bounding_box Result = { .Left = 0, .Top = 0, .Right = 0, .Bottom = 0 };
+    if(Output)
+    {
+        gui_point Screen = {.X = Output->Position.X, .Y = Output->Position.Y};
+        Result = (gui_bounding_box){.Left = Screen.X, .Top = Screen.Y, .Right = Screen.X + Output->Size.Width, .Bottom = Screen.Y + Output->Size.Height};
+    }
+    return Result;
+}
+
+
+static float
+GuiBoundingBoxSignedDistanceField(gui_point Point, gui_bounding_box BoundingBox)
+{
+    gui_dimensions Size   = (gui_dimensions){.Width = BoundingBox.Right - BoundingBox.Left, .Height = BoundingBox.Bottom - BoundingBox.Top};
+    gui_dimensions Half   = (gui_dimensions){.Width = Size.Width * 0.5f, .Height = Size.Height * 0.5f};
+    gui_point      Start  = (gui_point){.X = BoundingBox.Left, .Y = BoundingBox.Top};
+    gui_point      Center = (gui_point){.X = Start.X + Half.Width, .Y = Start.Y + Half.Height};
+    gui_point      Local  = (gui_point){.X = Point.X - Center.X, .Y = Point.Y - Center.Y};
+
+    gui_point FirstQuadrant = (gui_point){ .X = fabsf(Local.X) - Half.Width, .Y = fabsf(Local.Y) - Half.Height };
+
+    float OuterX        = (FirstQuadrant.X > 0.0f) ? FirstQuadrant.X : 0.0f;
+    float OuterY        = (FirstQuadrant.Y > 0.0f) ? FirstQuadrant.Y : 0.0f;
+    float OuterDistance = sqrtf(OuterX * OuterX + OuterY * OuterY);
+    float InnerDistance = fminf(fmaxf(FirstQuadrant.X, FirstQuadrant.Y), 0.0f);
+
+    float Result = OuterDistance + InnerDistance;
+    return Result;
+}
+
+
+static gui_bool
+GuiIsPointInsideOuterBox(gui_point Position, gui_layout_output *Output)
+{
+    gui_bool Result = GUI_FALSE;
+    if(Output)
+    {
+        gui_bounding_box Box = GuiGetLayoutNodeBoundingBox(Output);
+        float Distance = GuiBoundingBoxSignedDistanceField(Position, Box);
+        Result = Distance <= 0.0f;
+    }
+    return Result;
+}
+
+
+static gui_bool
+GuiIsPointInsideBorder(gui_point Position, gui_layout_output *Output)
+{
+    gui_bool Result = GUI_FALSE;
+
+    if(Output)
+    {
+        gui_bounding_box Box      = GuiGetLayoutNodeBoundingBox(Output);
+        float            Distance = GuiBoundingBoxSignedDistanceField(Position, Box);
+
+        Result = Distance >= 0.0f;
+    }
+
+    return Result;
+}
+
+
+//-----------------------------------------------------------------------------
+// [SECTION] LAYOUT RESPONSIVENESS INPUT HANDLING
+// [DESCRIP] When the user calls GuiBeginFrame we fire events at _some_ layout
+//           tree. These functions are responsible for handling those events.
+// [HISTORY]
+// : - 2026-10-17 Non-recursive hit-testing over the depth-first order
+// : - 2026-01-11 Basic Implementation
+//-----------------------------------------------------------------------------
+
+
+// The deepest node under the pointer is found with a single forward walk over the
+// depth-first order. A node that contains the point narrows the search to its own
+// subtree, one that does not is skipped with everything below it. The first child
+// that contains the point wins, its later siblings are never visited. Only the
+// output boxes are read, the rest of the node stays out of the cache.
+
+static uint32_t
+GuiFindHitNode(gui_point Position, gui_layout_tree *Tree)
+{
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    uint32_t Result = GuiInvalidIndex;
+
+    GuiUpdateDepthFirstOrder(Tree);
+
+    uint32_t At  = 0;
+    uint32_t End = Tree->DepthFirstCount;
+    while(At < End)
+    {
+        uint32_t NodeIndex = Tree->DepthFirst[At];
+        if(GuiIsPointInsideOuterBox(Position, &Tree->Outputs[NodeIndex]))
+        {
+            Result = NodeIndex;
+            End    = At + Tree->DepthFirstSize[At];
+            At    += 1;
+        }
+        else
+        {
+            At += Tree->DepthFirstSize[At];
+        }
+    }
+
+    return Result;
+}
+
+
+static gui_bool
+GuiHandlePointerClick(gui_point Position, uint32_t ClickMask, gui_layout_tree *Tree)
+{
+    GUI_UNUSED(ClickMask);
+
+    GUI_ASSERT(Position.X >= 0.0f && Position.Y >= 0.0f);
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        uint32_t          NodeIndex = GuiFindHitNode(Position, Tree);
+        gui_layout_state *Node      = GuiGetLayoutState(NodeIndex, Tree);
+        if(Node)
+        {
+            Node->State = Node->State | Gui_NodeState_IsClicked;
+            Node->State = Node->State | Gui_NodeState_UseFocusedStyle;
+            Node->State = Node->State | Gui_NodeState_HasCapturedPointer;
+
+            Tree->CapturedNodeIndex = NodeIndex;
+
+            return GUI_TRUE;
+        }
+    }
+
+    return GUI_FALSE;
+}
+
+
+static gui_bool
+GuiHandlePointerRelease(gui_point Position, uint32_t ReleaseMask, gui_layout_tree *Tree)
+{
+    GUI_UNUSED(ReleaseMask);
+
+    GUI_ASSERT(Position.X >= 0.0f && Position.Y >= 0.0f);
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        // Only the captured node can hold the pointer, there is nothing to search for.
+
+        gui_layout_state *Node = GuiGetLayoutState(Tree->CapturedNodeIndex, Tree);
+        if(Node && (Node->State & Gui_NodeState_HasCapturedPointer))
+        {
+            Node->State = Node->State & ~(Gui_NodeState_HasCapturedPointer | Gui_NodeState_UseFocusedStyle);
+
+            Tree->CapturedNodeIndex = GuiInvalidIndex;
+
+            return GUI_TRUE;
+        }
+    }
+
+    return GUI_FALSE;
+}
+
+
+static gui_bool
+GuiHandlePointerHover(gui_point Position, gui_layout_tree *Tree)
+{
+    GUI_ASSERT(Position.X >= 0.0f && Position.Y >= 0.0f);
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        gui_layout_state *Node = GuiGetLayoutState(GuiFindHitNode(Position, Tree), Tree);
+        if(Node)
+        {
+            Node->State = Node->State | Gui_NodeState_UseHoveredStyle;
+
+            return GUI_TRUE;
+        }
+    }
+
+    return GUI_FALSE;
+}
+
+
+static void
+GuiHandlePointerMove(float DeltaX, float DeltaY, gui_layout_tree *Tree)
+{
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        gui_layout_state  *CapturedState  = GuiGetLayoutState(Tree->CapturedNodeIndex, Tree);
+        gui_layout_output *CapturedOutput = GuiGetLayoutOutput(Tree->CapturedNodeIndex, Tree);
+        if(CapturedState && CapturedOutput)
+        {
+            if(CapturedState->Flags & Gui_NodeFlags_IsDraggable)
+            {
+                CapturedOutput->Position.X += DeltaX;
+                CapturedOutput->Position.Y += DeltaY;
+
+                GuiMarkLayoutDirty(Tree->CapturedNodeIndex, Gui_LayoutDirty_Place, Tree);
+            }
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// [SECTION] LAYOUT COMPUTATION CORE
+// [DESCRIP] Two-pass layout: a bottom-up measure followed by a top-down arrange.
+// [HISTORY]
+// : - 2026-10-18 Measuring a wrapping node resolves percent children against its break size
+// : - 2026-10-18 Queued boundaries are measured before any arrange, measure consumes Descendant
+// : - 2026-10-17 Arrange flags moved children, the caller journals them
+// : - 2026-10-17 Children are placed relative to the content offset
+// : - 2026-10-17 Wrapping horizontal/vertical nodes with cached line breaks
+// : - 2026-10-17 Grid direction: measure and arrange children into track cells
+// : - 2026-10-17 Memoize subtree layouts through the resource table
+// : - 2026-10-17 Split large trees into independent subtree tasks
+// : - 2026-10-17 Resolve child sizes four at a time with SSE2
+// : - 2026-10-17 Measure/arrange walk the depth-first order instead of recursing
+// : - 2026-10-17 Flex grow/shrink along the major axis
+// : - 2026-10-17 Fit sizing from cached intrinsic sizes
+// : - 2026-10-17 Replaced the convergence loop with measure/arrange passes
+// : - 2026-10-17 Skip clean subtrees using per-node dirty flags
+// : - 2026-01-11 Basic Implementation
+//-----------------------------------------------------------------------------
+
+
+static float
+GuiGetAlignmentOffset(Gui_Alignment AlignmentType, float FreeSpace)
+{
+    float Result = 0.0f;
+
+    if(FreeSpace > 0.0f)
+    {
+        switch(AlignmentType)
+        {
+
+        case Gui_Alignment_None:
+        case Gui_Alignment_Start:
+        {
+            // No-Op
+        } break;
+
+        case Gui_Alignment_Center:
+        {
+            Result = 0.5f * FreeSpace;
+        } break;
+
+        case Gui_Alignment_End:
+        {
+            // TODO: implement end alignment
+        } break;
+
+        }
+    }
+
+    return Result;
+}
+
+
+static float
+GuiComputeNodeSize(gui_sizing Sizing, float ParentSize)
+{
+    float Result = 0.0f;
+
+    switch(Sizing.Type)
+    {
+
+    case Gui_LayoutSizing_None:
+    {
+    } break;
+
+    case Gui_LayoutSizing_Fixed:
+    {
+        Result = Sizing.Value;
+    } break;
+
+    case Gui_LayoutSizing_Percent:
+    {
+        GUI_ASSERT(Sizing.Value >= 0.0f && Sizing.Value <= 100.0f);
+        Result = (Sizing.Value / 100.0f) * ParentSize;
+    } break;
+
+    case Gui_LayoutSizing_Fit:
+    {
+        // Fit depends on the children and is computed by the measure pass.
+    } break;
+
+    case Gui_LayoutSizing_Fraction:
+    {
+        // Fractions only mean something for grid tracks.
+    } break;
+
+    }
+
+    return Result;
+}
+
+
+static float
+GuiComputeMaxSize(gui_sizing Sizing, float ParentSize)
+{
+    // An unset maximum does not constrain the node.
+    float Result = (Sizing.Type == Gui_LayoutSizing_None) ? INFINITY : GuiComputeNodeSize(Sizing, ParentSize);
+    return Result;
+}
+
+
+static float
+GuiClampNodeSize(float Size, gui_sizing MinSize, gui_sizing MaxSize, float ParentSize)
+{
+    float Min    = GuiComputeNodeSize(MinSize, ParentSize);
+    float Max    = GuiComputeMaxSize(MaxSize, ParentSize);
+    float Result = fmaxf(Min, fminf(Size, Max));
+    return Result;
+}
+
+
+static float
+GuiMeasureAxis(gui_sizing Size, gui_sizing MinSize, gui_sizing MaxSize, float FitSize)
+{
+    // Fixed and fit values are known bottom-up. Percent sizes wait for the
+    // parent's final size and measure as zero.
+
+    float Result = 0.0f;
+
+    if(Size.Type == Gui_LayoutSizing_Fixed)
+    {
+        Result = Size.Value;
+    }
+    else if(Size.Type == Gui_LayoutSizing_Fit)
+    {
+        Result = FitSize;
+    }
+
+    if(MinSize.Type == Gui_LayoutSizing_Fixed)
+    {
+        Result = fmaxf(Result, MinSize.Value);
+    }
+
+    if(MaxSize.Type == Gui_LayoutSizing_Fixed)
+    {
+        Result = fminf(Result, MaxSize.Value);
+    }
+
+    return Result;
+}
+
+
+static float
+GuiResolveAxis(gui_sizing Size, gui_sizing MinSize, gui_sizing MaxSize, float Intrinsic, float ParentSize)
+{
+    float Value  = (Size.Type == Gui_LayoutSizing_Percent) ? GuiComputeNodeSize(Size, ParentSize) : Intrinsic;
+    float Result = GuiClampNodeSize(Value, MinSize, MaxSize, ParentSize);
+    return Result;
+}
+
+
+static gui_dimensions
+GuiGetContentBounds(gui_layout_input *Input, gui_layout_output *Output, uint32_t ChildCount)
+{
+    gui_dimensions Result =
+    {
+        .Width  = Output->Size.Width  - (Input->Padding.Left + Input->Padding.Right),
+        .Height = Output->Size.Height - (Input->Padding.Top  + Input->Padding.Bottom),
+    };
+
+    // Wrapped children only share the major axis with the other children on their line.
+    if(ChildCount > 0 && !Input->Wrap)
+    {
+        float Spacing = Input->Spacing * (float)(ChildCount - 1);
+        if(Input->Direction == Gui_LayoutDirection_Horizontal)
+        {
+            Result.Width -= Spacing;
+        }
+        else if(Input->Direction == Gui_LayoutDirection_Vertical)
+        {
+            Result.Height -= Spacing;
+        }
+    }
+
+    Result.Width  = fmaxf(Result.Width , 0.0f);
+    Result.Height = fmaxf(Result.Height, 0.0f);
+
+    return Result;
+}
+
+
+// Grid tracks are sized like nodes: fixed and fit tracks are known bottom-up,
+// percent tracks resolve against the content box and fractions share whatever
+// the other tracks leave. The measure pass finds the largest child in each track
+// and the height of the extra rows, which are always sized to fit.
+
+static void
+GuiMeasureGridContent(gui_layout_node *Node, gui_layout_grid *Grid, gui_layout_tree *Tree)
+{
+    uint32_t ColumnCount = Grid->Tracks.ColumnCount;
+    uint32_t Cell        = 0;
+    float    RowHeight   = 0.0f;
+
+    for(uint32_t Idx = 0; Idx < GUI_MAX_GRID_TRACKS; ++Idx)
+    {
+        Grid->ColumnFit[Idx] = 0.0f;
+        Grid->RowFit[Idx]    = 0.0f;
+    }
+
+    Grid->ExtraRowHeight = 0.0f;
+
+    for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree), ++Cell)
+    {
+        gui_dimensions Intrinsic = GuiGetLayoutMeasure(Child->Index, Tree)->IntrinsicSize;
+        uint32_t       Column    = Cell % ColumnCount;
+        uint32_t       Row       = Cell / ColumnCount;
+
+        Grid->ColumnFit[Column] = fmaxf(Grid->ColumnFit[Column], Intrinsic.Width);
+
+        if(Row < Grid->Tracks.RowCount)
+        {
+            Grid->RowFit[Row] = fmaxf(Grid->RowFit[Row], Intrinsic.Height);
+        }
+        else
+        {
+            RowHeight = fmaxf(RowHeight, Intrinsic.Height);
+
+            if(Column == ColumnCount - 1)
+            {
+                Grid->ExtraRowHeight += RowHeight;
+                RowHeight             = 0.0f;
+            }
+        }
+    }
+
+    // The last extra row may not be full.
+    Grid->ExtraRowHeight += RowHeight;
+
+    uint32_t FilledRows = (Cell + ColumnCount - 1) / ColumnCount;
+    Grid->RowCount      = (FilledRows > Grid->Tracks.RowCount) ? FilledRows : Grid->Tracks.RowCount;
+}
+
+
+static float
+GuiMeasureGridTrack(gui_sizing Track, float Fit)
+{
+    // Percent tracks wait for the grid's final size and measure as zero. A fraction
+    // track wants at least enough room for its largest child.
+
+    float Result = Fit;
+
+    if(Track.Type == Gui_LayoutSizing_Fixed)
+    {
+        Result = Track.Value;
+    }
+    else if(Track.Type == Gui_LayoutSizing_Percent)
+    {
+        Result = 0.0f;
+    }
+
+    return Result;
+}
+
+
+static gui_dimensions
+GuiMeasureGrid(gui_layout_input *Input, gui_layout_grid *Grid)
+{
+    gui_dimensions Result = { .Width = 0.0f, .Height = Grid->ExtraRowHeight };
+
+    for(uint32_t Idx = 0; Idx < Grid->Tracks.ColumnCount; ++Idx)
+    {
+        Result.Width += GuiMeasureGridTrack(Grid->Tracks.Columns[Idx], Grid->ColumnFit[Idx]);
+    }
+
+    for(uint32_t Idx = 0; Idx < Grid->Tracks.RowCount; ++Idx)
+    {
+        Result.Height += GuiMeasureGridTrack(Grid->Tracks.Rows[Idx], Grid->RowFit[Idx]);
+    }
+
+    Result.Width += Input->Spacing * (float)(Grid->Tracks.ColumnCount - 1);
+
+    if(Grid->RowCount > 0)
+    {
+        Result.Height += Input->Spacing * (float)(Grid->RowCount - 1);
+    }
+
+    return Result;
+}
+
+
+static void
+GuiResolveGridTracks(gui_sizing *Tracks, float *Fit, uint32_t Count, float ContentSize, float Available, float *Sizes)
+{
+    float Used   = 0.0f;
+    float Weight = 0.0f;
+
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        if(Tracks[Idx].Type == Gui_LayoutSizing_Fraction)
+        {
+            Sizes[Idx] = 0.0f;
+            Weight    += fmaxf(Tracks[Idx].Value, 0.0f);
+        }
+        else
+        {
+            Sizes[Idx] = (Tracks[Idx].Type == Gui_LayoutSizing_Fit || Tracks[Idx].Type == Gui_LayoutSizing_None) ? Fit[Idx] : GuiComputeNodeSize(Tracks[Idx], ContentSize);
+            Used      += Sizes[Idx];
+        }
+    }
+
+    if(Weight > 0.0f)
+    {
+        float Free = fmaxf(Available - Used, 0.0f);
+
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            if(Tracks[Idx].Type == Gui_LayoutSizing_Fraction)
+            {
+                Sizes[Idx] = Free * (fmaxf(Tracks[Idx].Value, 0.0f) / Weight);
+            }
+        }
+    }
+}
+
+
+// A wrapping node starts a new line whenever the next child would overflow its
+// content size along the major axis. Measuring breaks the intrinsic sizes without
+// storing anything. Arranging breaks the resolved sizes and stores the lines, they
+// are reused until the content size or the size of a child changes.
+
+static gui_bool
+GuiIsWrapping(gui_layout_input *Input)
+{
+    gui_bool Result = Input->Wrap && (Input->Direction == Gui_LayoutDirection_Horizontal || Input->Direction == Gui_LayoutDirection_Vertical);
+    return Result;
+}
+
+
+static float
+GuiGetWrapBreakSize(gui_layout_input *Input, gui_layout_output *Output)
+{
+    // The major size is only known bottom-up when it is fixed or capped. A percent
+    // size is resolved by the parent, the last arranged size stands in for it.
+
+    gui_bool   IsXMajor = (Input->Direction == Gui_LayoutDirection_Horizontal);
+    gui_sizing Size     = IsXMajor ? Input->Size.Width    : Input->Size.Height;
+    gui_sizing MinSize  = IsXMajor ? Input->MinSize.Width : Input->MinSize.Height;
+    gui_sizing MaxSize  = IsXMajor ? Input->MaxSize.Width : Input->MaxSize.Height;
+    float      Padding  = IsXMajor ? Input->Padding.Left + Input->Padding.Right : Input->Padding.Top + Input->Padding.Bottom;
+    float      Result   = INFINITY;
+
+    if(Size.Type == Gui_LayoutSizing_Fixed)
+    {
+        Result = GuiMeasureAxis(Size, MinSize, MaxSize, 0.0f);
+    }
+    else if(Size.Type == Gui_LayoutSizing_Percent)
+    {
+        Result = IsXMajor ? Output->Size.Width : Output->Size.Height;
+    }
+    else if(MaxSize.Type == Gui_LayoutSizing_Fixed)
+    {
+        Result = MaxSize.Value;
+    }
+
+    Result = fmaxf(Result - Padding, 0.0f);
+    return Result;
+}
+
+
+// Returns the longest line along X and the stacked lines along Y, in major/minor order.
+
+static gui_dimensions
+GuiBreakLines(gui_layout_node *Node, float BreakSize, gui_bool IsMeasuring, gui_layout_tree *Tree)
+{
+    gui_layout_input *Input    = GuiGetLayoutInput(Node->Index, Tree);
+    gui_layout_wrap  *Wrap     = Tree->Wraps + Node->Index;
+    gui_bool          IsXMajor = (Input->Direction == Gui_LayoutDirection_Horizontal);
+
+    gui_dimensions   Result    = { .Width = 0.0f, .Height = 0.0f };
+    gui_layout_wrap *Line      = 0;
+    uint32_t         LineCount = 0;
+    uint32_t         Lines     = 0;
+    float            LineMajor = 0.0f;
+    float            LineMinor = 0.0f;
+
+    if(!IsMeasuring)
+    {
+        Wrap->Stamp += 1;
+    }
+
+    for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
+    {
+        gui_dimensions Size  = IsMeasuring ? GuiGetLayoutMeasure(Child->Index, Tree)->IntrinsicSize : GuiGetLayoutOutput(Child->Index, Tree)->Size;
+        float          Major = IsXMajor ? Size.Width  : Size.Height;
+        float          Minor = IsXMajor ? Size.Height : Size.Width;
+
+        // A percent child has no intrinsic major size. It is resolved against the size
+        // the lines are broken against, as arranging does.
+        if(IsMeasuring && BreakSize < INFINITY)
+        {
+            gui_layout_input *ChildInput = GuiGetLayoutInput(Child->Index, Tree);
+            gui_sizing        MajorSize  = IsXMajor ? ChildInput->Size.Width : ChildInput->Size.Height;
+
+            if(MajorSize.Type == Gui_LayoutSizing_Percent)
+            {
+                gui_sizing MinSize = IsXMajor ? ChildInput->MinSize.Width : ChildInput->MinSize.Height;
+                gui_sizing MaxSize = IsXMajor ? ChildInput->MaxSize.Width : ChildInput->MaxSize.Height;
+
+                Major = GuiResolveAxis(MajorSize, MinSize, MaxSize, Major, BreakSize);
+            }
+        }
+
+        if(LineCount > 0 && LineMajor + Input->Spacing + Major > BreakSize)
+        {
+            Result.Width   = fmaxf(Result.Width, LineMajor);
+            Result.Height += LineMinor + (Lines > 0 ? Input->Spacing : 0.0f);
+            Lines         += 1;
+
+            if(Line)
+            {
+                Line->LineCount = LineCount;
+                Line->LineMajor = LineMajor;
+                Line->LineMinor = LineMinor;
+            }
+
+            LineCount = 0;
+        }
+
+        if(LineCount == 0)
+        {
+            LineMajor = Major;
+            LineMinor = Minor;
+
+            if(!IsMeasuring)
+            {
+                Line            = Tree->Wraps + Child->Index;
+                Line->LineOwner = Node->Index;
+                Line->LineStamp = Wrap->Stamp;
+            }
+        }
+        else
+        {
+            LineMajor += Input->Spacing + Major;
+            LineMinor  = fmaxf(LineMinor, Minor);
+        }
+
+        LineCount += 1;
+    }
+
+    if(LineCount > 0)
+    {
+        Result.Width   = fmaxf(Result.Width, LineMajor);
+        Result.Height += LineMinor + (Lines > 0 ? Input->Spacing : 0.0f);
+
+        if(Line)
+        {
+            Line->LineCount = LineCount;
+            Line->LineMajor = LineMajor;
+            Line->LineMinor = LineMinor;
+        }
+    }
+
+    return Result;
+}
+
+
+static void
+GuiPlaceLines(gui_layout_node *Node, float MajorSize, gui_layout_tree *Tree)
+{
+    gui_layout_input  *Input    = GuiGetLayoutInput(Node->Index, Tree);
+    gui_layout_output *Output   = GuiGetLayoutOutput(Node->Index, Tree);
+    gui_bool           IsXMajor = (Input->Direction == Gui_LayoutDirection_Horizontal);
+
+    Gui_Alignment MajorAlign = IsXMajor ? Input->XAlign : Input->YAlign;
+    Gui_Alignment MinorAlign = IsXMajor ? Input->YAlign : Input->XAlign;
+    float         OriginX    = Output->Position.X + Input->Padding.Left - Input->ContentOffset.X;
+    float         OriginY    = Output->Position.Y + Input->Padding.Top  - Input->ContentOffset.Y;
+
+    float    MajorCursor = 0.0f;
+    float    MinorCursor = 0.0f;
+    float    LineMinor   = 0.0f;
+    uint32_t Remaining   = 0;
+
+    for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
+    {
+        gui_layout_input  *ChildInput  = GuiGetLayoutInput(Child->Index, Tree);
+        gui_layout_output *ChildOutput = GuiGetLayoutOutput(Child->Index, Tree);
+
+        if(Remaining == 0)
+        {
+            gui_layout_wrap *Line = Tree->Wraps + Child->Index;
+
+            Remaining   = Line->LineCount;
+            LineMinor   = Line->LineMinor;
+            MajorCursor = GuiGetAlignmentOffset(MajorAlign, MajorSize - Line->LineMajor);
+        }
+
+        float ChildMajor  = IsXMajor ? ChildOutput->Size.Width  : ChildOutput->Size.Height;
+        float ChildMinor  = IsXMajor ? ChildOutput->Size.Height : ChildOutput->Size.Width;
+        float MinorOffset = MinorCursor + GuiGetAlignmentOffset(MinorAlign, LineMinor - ChildMinor);
+
+        gui_point Position =
+        {
+            .X = OriginX + (IsXMajor ? MajorCursor : MinorOffset) + ChildInput->AnimatedOffset.X,
+            .Y = OriginY + (IsXMajor ? MinorOffset : MajorCursor) + ChildInput->AnimatedOffset.Y,
+        };
+
+        if((Position.X != ChildOutput->Position.X) || (Position.Y != ChildOutput->Position.Y))
+        {
+            ChildOutput->Position = Position;
+            Tree->States[Child->Index].Dirty |= Gui_LayoutDirty_Place | Gui_LayoutDirty_Moved;
+        }
+
+        MajorCursor += ChildMajor + Input->Spacing;
+        Remaining   -= 1;
+
+        if(Remaining == 0)
+        {
+            MinorCursor += LineMinor + Input->Spacing;
+        }
+    }
+}
+
+
+// Measure runs bottom-up and computes the size a node wants regardless of its
+// parent. It is called in reverse depth-first order, so the children of a node
+// are always measured before it. A fit-sized axis depends on its children, so a percent-sized child on
+// that same axis would depend on its parent in turn. Such cycles are not iterated,
+// they are reported and the child is resolved against whatever size the parent ends up with.
+
+static void
+GuiMeasureLayout(gui_layout_node *Node, gui_layout_tree *Tree, gui_layout_stats *Stats)
+{
+    GUI_ASSERT(GuiIsValidLayoutNode(Node));
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    gui_layout_state *State = GuiGetLayoutState(Node->Index, Tree);
+
+    if(!(State->Dirty & (Gui_LayoutDirty_Measure | Gui_LayoutDirty_Descendant)))
+    {
+        return;
+    }
+
+    gui_layout_input   *Input   = GuiGetLayoutInput(Node->Index, Tree);
+    gui_layout_output  *Output  = GuiGetLayoutOutput(Node->Index, Tree);
+    gui_layout_measure *Measure = GuiGetLayoutMeasure(Node->Index, Tree);
+
+    gui_bool IsWidthFit  = (Input->Size.Width.Type  == Gui_LayoutSizing_Fit);
+    gui_bool IsHeightFit = (Input->Size.Height.Type == Gui_LayoutSizing_Fit);
+    gui_bool IsXMajor    = (Input->Direction == Gui_LayoutDirection_Horizontal);
+
+    // Children are summed along the major axis and maxed along the minor one.
+
+    float Major = 0.0f;
+    float Minor = 0.0f;
+
+    for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
+    {
+        gui_layout_input   *ChildInput   = GuiGetLayoutInput(Child->Index, Tree);
+        gui_layout_measure *ChildMeasure = GuiGetLayoutMeasure(Child->Index, Tree);
+
+        if((IsWidthFit && ChildInput->Size.Width.Type == Gui_LayoutSizing_Percent) || (IsHeightFit && ChildInput->Size.Height.Type == Gui_LayoutSizing_Percent))
+        {
+            ++Stats->SizingCycleCount;
+        }
+
+        Major += IsXMajor ? ChildMeasure->IntrinsicSize.Width  : ChildMeasure->IntrinsicSize.Height;
+        Minor  = fmaxf(Minor, IsXMajor ? ChildMeasure->IntrinsicSize.Height : ChildMeasure->IntrinsicSize.Width);
+    }
+
+    if(Node->ChildCount > 0)
+    {
+        Major += Input->Spacing * (float)(Node->ChildCount - 1);
+    }
+
+    gui_dimensions Content =
+    {
+        .Width  = IsXMajor ? Major : Minor,
+        .Height = IsXMajor ? Minor : Major,
+    };
+
+    gui_layout_grid *Grid = GuiGetLayoutGrid(Node->Index, Tree);
+
+    if(Grid)
+    {
+        GuiMeasureGridContent(Node, Grid, Tree);
+
+        Content = GuiMeasureGrid(Input, Grid);
+    }
+    else if(GuiIsWrapping(Input))
+    {
+        gui_dimensions Lines = GuiBreakLines(Node, GuiGetWrapBreakSize(Input, Output), GUI_TRUE, Tree);
+
+        Content = (gui_dimensions){ .Width = IsXMajor ? Lines.Width : Lines.Height, .Height = IsXMajor ? Lines.Height : Lines.Width };
+
+        Tree->Wraps[Node->Index].MeasuredExtent = Lines.Height;
+    }
+
+    gui_dimensions FitSize =
+    {
+        .Width  = Content.Width  + Input->Padding.Left + Input->Padding.Right,
+        .Height = Content.Height + Input->Padding.Top  + Input->Padding.Bottom,
+    };
+
+    gui_dimensions Intrinsic =
+    {
+        .Width  = GuiMeasureAxis(Input->Size.Width , Input->MinSize.Width , Input->MaxSize.Width , FitSize.Width),
+        .Height = GuiMeasureAxis(Input->Size.Height, Input->MinSize.Height, Input->MaxSize.Height, FitSize.Height),
+    };
+
+    if((Intrinsic.Width != Measure->IntrinsicSize.Width) || (Intrinsic.Height != Measure->IntrinsicSize.Height))
+    {
+        Measure->IntrinsicSize = Intrinsic;
+        State->Dirty          |= Gui_LayoutDirty_Place;
+    }
+
+    if(State->Dirty & Gui_LayoutDirty_Descendant)
+    {
+        State->Dirty |= Gui_LayoutDirty_Place;
+    }
+
+    Measure->SubtreeHash = GuiHashLayoutNode(Node, Tree);
+    State->Dirty        &= ~(Gui_LayoutDirty_Measure | Gui_LayoutDirty_Descendant);
+
+    ++Stats->MeasuredCount;
+}
+
+
+// Flex distributes the free space along the major axis. We solve for a single ratio:
+// a child's size is its base size plus Ratio * Weight, clamped to its min/max. Each
+// round re-computes the sizes of the active children, freezes the clamped ones and
+// corrects the ratio with what is left. The ratio only moves towards the solution,
+// so a frozen child stays clamped and its size is folded into a running total. The
+// active children are compacted in place into the node's slice of the depth-first
+// scratch, so a round only visits those. A round freezes at least one more child or
+// terminates, so the number of rounds is bounded by the child count.
+
+typedef struct gui_flex_state
+{
+    gui_bool IsXMajor;
+    gui_bool IsGrowing;
+    float    Ratio;
+} gui_flex_state;
+
+
+static float
+GuiGetFlexSize(gui_layout_input *Child, gui_layout_measure *ChildMeasure, gui_dimensions ContentBounds, gui_flex_state *Flex, float *ActiveWeight)
+{
+    gui_sizing Size       = Flex->IsXMajor ? Child->Size.Width                 : Child->Size.Height;
+    gui_sizing MinSize    = Flex->IsXMajor ? Child->MinSize.Width              : Child->MinSize.Height;
+    gui_sizing MaxSize    = Flex->IsXMajor ? Child->MaxSize.Width              : Child->MaxSize.Height;
+    float      Intrinsic  = Flex->IsXMajor ? ChildMeasure->IntrinsicSize.Width : ChildMeasure->IntrinsicSize.Height;
+    float      ParentSize = Flex->IsXMajor ? ContentBounds.Width               : ContentBounds.Height;
+
+    float Base   = GuiResolveAxis(Size, MinSize, MaxSize, Intrinsic, ParentSize);
+    float Weight = Flex->IsGrowing ? Child->Grow : Child->Shrink * Base;
+    float Target = Flex->IsGrowing ? Base + Flex->Ratio * Weight : Base - Flex->Ratio * Weight;
+    float Result = GuiClampNodeSize(Target, MinSize, MaxSize, ParentSize);
+
+    // A clamped child is frozen, it no longer takes part in the distribution.
+    if(ActiveWeight)
+    {
+        *ActiveWeight = (Weight > 0.0f && Result == Target) ? Weight : 0.0f;
+    }
+
+    return Result;
+}
+
+
+static void
+GuiSolveFlex(gui_layout_node *Node, gui_layout_tree *Tree, gui_dimensions ContentBounds, gui_flex_state *Flex)
+{
+    float     Available   = Flex->IsXMajor ? ContentBounds.Width : ContentBounds.Height;
+    float     BaseTotal   = 0.0f;
+    float     FrozenTotal = 0.0f;
+    uint32_t *Active      = Tree->DepthFirstScratch + Node->DepthFirstIndex;
+    uint32_t  ActiveCount = 0;
+
+    for(gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
+    {
+        BaseTotal += GuiGetFlexSize(GuiGetLayoutInput(Child->Index, Tree), GuiGetLayoutMeasure(Child->Index, Tree), ContentBounds, Flex, 0);
+        Active[ActiveCount++] = Child->Index;
+    }
+
+    Flex->IsGrowing = (BaseTotal < Available);
+
+    for(uint32_t Round = 0; Round <= Node->ChildCount; ++Round)
+    {
+        float    Total        = FrozenTotal;
+        float    ActiveWeight = 0.0f;
+        uint32_t KeptCount    = 0;
+
+        for(uint32_t Idx = 0; Idx < ActiveCount; ++Idx)
+        {
+            float Weight = 0.0f;
+            float Size   = GuiGetFlexSize(GuiGetLayoutInput(Active[Idx], Tree), GuiGetLayoutMeasure(Active[Idx], Tree), ContentBounds, Flex, &Weight);
+
+            Total += Size;
+
+            if(Weight > 0.0f)
+            {
+                ActiveWeight        += Weight;
+                Active[KeptCount++]  = Active[Idx];
+            }
+            else
+            {
+                FrozenTotal += Size;
+            }
+        }
+
+        ActiveCount = KeptCount;
+
+        float Remaining = Flex->IsGrowing ? Available - Total : Total - Available;
+        if(ActiveWeight <= 0.0f || fabsf(Remaining) < 0.01f)
+        {
+            break;
+        }
+
+        Flex->Ratio = fmaxf(Flex->Ratio + Remaining / ActiveWeight, 0.0f);
+    }
+}
+
+
+// Resolving a child's size is a select on the sizing type followed by a clamp. Every
+// sizing reduces to Constant + Scale * ParentSize: percent sizes only have a scale,
+// fixed sizes only a constant, and a node's own size falls back to its intrinsic size.
+// Written that way, the children of a wide container are resolved four at a time
+// with the same arithmetic as the scalar path, so both give bit-identical results.
+
+#define GUI_SIZING_BATCH 4
+
+typedef struct gui_sizing_terms
+{
+    float Constant[GUI_SIZING_BATCH];
+    float Scale[GUI_SIZING_BATCH];
+} gui_sizing_terms;
+
+
+static void
+GuiGetSizingTerms(gui_sizing Sizing, float Unset, gui_sizing_terms *Terms, uint32_t Lane)
+{
+    gui_bool IsPercent = (Sizing.Type == Gui_LayoutSizing_Percent);
+    gui_bool IsFixed   = (Sizing.Type == Gui_LayoutSizing_Fixed);
+    gui_bool IsUnset   = (Sizing.Type == Gui_LayoutSizing_None);
+
+    GUI_ASSERT(!IsPercent || (Sizing.Value >= 0.0f && Sizing.Value <= 100.0f));
+
+    Terms->Scale[Lane]    = IsPercent ? Sizing.Value / 100.0f : 0.0f;
+    Terms->Constant[Lane] = IsFixed   ? Sizing.Value : (IsUnset ? Unset : 0.0f);
+}
+
+
+static void
+GuiResolveChildSizes(uint32_t *ChildIndices, uint32_t Count, gui_dimensions ContentBounds, gui_dimensions *Sizes, gui_layout_tree *Tree)
+{
+    GUI_ASSERT(Count <= GUI_SIZING_BATCH);
+
+#if GUI_SSE2
+    if(Count == GUI_SIZING_BATCH)
+    {
+        gui_sizing_terms Size[2], MinSize[2], MaxSize[2];
+
+        for(uint32_t Lane = 0; Lane < GUI_SIZING_BATCH; ++Lane)
+        {
+            gui_layout_input   *Input   = GuiGetLayoutInput(ChildIndices[Lane], Tree);
+            gui_layout_measure *Measure = GuiGetLayoutMeasure(ChildIndices[Lane], Tree);
+
+            GuiGetSizingTerms(Input->Size.Width    , 0.0f    , &Size[0]   , Lane);
+            GuiGetSizingTerms(Input->Size.Height   , 0.0f    , &Size[1]   , Lane);
+            GuiGetSizingTerms(Input->MinSize.Width , 0.0f    , &MinSize[0], Lane);
+            GuiGetSizingTerms(Input->MinSize.Height, 0.0f    , &MinSize[1], Lane);
+            GuiGetSizingTerms(Input->MaxSize.Width , INFINITY, &MaxSize[0], Lane);
+            GuiGetSizingTerms(Input->MaxSize.Height, INFINITY, &MaxSize[1], Lane);
+
+            // Anything that is not a percentage resolves to the measured size.
+            if(Input->Size.Width.Type != Gui_LayoutSizing_Percent)
+            {
+                Size[0].Constant[Lane] = Measure->IntrinsicSize.Width;
+            }
+
+            if(Input->Size.Height.Type != Gui_LayoutSizing_Percent)
+            {
+                Size[1].Constant[Lane] = Measure->IntrinsicSize.Height;
+            }
+        }
+
+        float Resolved[2][GUI_SIZING_BATCH];
+        float ParentSize[2] = {ContentBounds.Width, ContentBounds.Height};
+
+        for(uint32_t Axis = 0; Axis < 2; ++Axis)
+        {
+            __m128 Parent = _mm_set1_ps(ParentSize[Axis]);
+            __m128 Value  = _mm_add_ps(_mm_loadu_ps(Size[Axis].Constant)   , _mm_mul_ps(_mm_loadu_ps(Size[Axis].Scale)   , Parent));
+            __m128 Min    = _mm_add_ps(_mm_loadu_ps(MinSize[Axis].Constant), _mm_mul_ps(_mm_loadu_ps(MinSize[Axis].Scale), Parent));
+            __m128 Max    = _mm_add_ps(_mm_loadu_ps(MaxSize[Axis].Constant), _mm_mul_ps(_mm_loadu_ps(MaxSize[Axis].Scale), Parent));
+
+            _mm_storeu_ps(Resolved[Axis], _mm_max_ps(Min, _mm_min_ps(Value, Max)));
+        }
+
+        for(uint32_t Lane = 0; Lane < GUI_SIZING_BATCH; ++Lane)
+        {
+            Sizes[Lane] = (gui_dimensions){ .Width = Resolved[0][Lane], .Height = Resolved[1][Lane] };
+        }
+
+        return;
+    }
+#endif
+
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        gui_layout_input   *Input   = GuiGetLayoutInput(ChildIndices[Idx], Tree);
+        gui_layout_measure *Measure = GuiGetLayoutMeasure(ChildIndices[Idx], Tree);
+
+        Sizes[Idx] = (gui_dimensions)
+        {
+            .Width  = GuiResolveAxis(Input->Size.Width , Input->MinSize.Width , Input->MaxSize.Width , Measure->IntrinsicSize.Width , ContentBounds.Width),
+            .Height = GuiResolveAxis(Input->Size.Height, Input->MinSize.Height, Input->MaxSize.Height, Measure->IntrinsicSize.Height, ContentBounds.Height),
+        };
+    }
+}
+
+
+// Children go into cells row by row. A child resolves its size against its cell
+// and is aligned inside it. Extra rows take the height of their tallest child, so
+// a row is gathered before it is placed, but each child is still visited once.
+
+static void
+GuiArrangeGrid(gui_layout_node *Node, gui_layout_tree *Tree)
+{
+    gui_layout_input   *Input   = GuiGetLayoutInput(Node->Index, Tree);
+    gui_layout_output  *Output  = GuiGetLayoutOutput(Node->Index, Tree);
+    gui_layout_measure *Measure = GuiGetLayoutMeasure(Node->Index, Tree);
+    gui_layout_grid    *Grid    = GuiGetLayoutGrid(Node->Index, Tree);
+
+    gui_dimensions ContentBounds = GuiGetContentBounds(Input, Output, Node->ChildCount);
+    uint32_t       ColumnCount   = Grid->Tracks.ColumnCount;
+    float          ColumnGaps    = Input->Spacing * (float)(ColumnCount - 1);
+    float          RowGaps       = (Grid->RowCount > 0) ? Input->Spacing * (float)(Grid->RowCount - 1) : 0.0f;
+
+    float ColumnSize[GUI_MAX_GRID_TRACKS];
+    float RowSize[GUI_MAX_GRID_TRACKS];
+
+    GuiResolveGridTracks(Grid->Tracks.Columns, Grid->ColumnFit, ColumnCount, ContentBounds.Width, ContentBounds.Width - ColumnGaps, ColumnSize);
+    GuiResolveGridTracks(Grid->Tracks.Rows, Grid->RowFit, Grid->Tracks.RowCount, ContentBounds.Height, ContentBounds.Height - RowGaps - Grid->ExtraRowHeight, RowSize);
+
+    Measure->ChildSize = (gui_dimensions){ .Width = ColumnGaps, .Height = RowGaps + Grid->ExtraRowHeight };
+
+    for(uint32_t Idx = 0; Idx < ColumnCount; ++Idx)
+    {
+        Measure->ChildSize.Width += ColumnSize[Idx];
+    }
+
+    for(uint32_t Idx = 0; Idx < Grid->Tracks.RowCount; ++Idx)
+    {
+        Measure->ChildSize.Height += RowSize[Idx];
+    }
+
+    float    CursorY = Output->Position.Y + Input->Padding.Top - Input->ContentOffset.Y;
+    uint32_t Row     = 0;
+
+    gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree);
+    while(GuiIsValidLayoutNode(Child))
+    {
+        uint32_t Cells[GUI_MAX_GRID_TRACKS];
+        uint32_t CellCount = 0;
+        float    RowHeight = 0.0f;
+
+        for(; GuiIsValidLayoutNode(Child) && CellCount < ColumnCount; Child = GuiGetLayoutNode(Child->Next, Tree))
+        {
+            RowHeight          = fmaxf(RowHeight, GuiGetLayoutMeasure(Child->Index, Tree)->IntrinsicSize.Height);
+            Cells[CellCount++] = Child->Index;
+        }
+
+        if(Row < Grid->Tracks.RowCount)
+        {
+            RowHeight = RowSize[Row];
+        }
+
+        float CursorX = Output->Position.X + Input->Padding.Left - Input->ContentOffset.X;
+
+        for(uint32_t Column = 0; Column < CellCount; ++Column)
+        {
+            gui_layout_input   *ChildInput   = GuiGetLayoutInput(Cells[Column], Tree);
+            gui_layout_output  *ChildOutput  = GuiGetLayoutOutput(Cells[Column], Tree);
+            gui_layout_measure *ChildMeasure = GuiGetLayoutMeasure(Cells[Column], Tree);
+
+            gui_dimensions Size =
+            {
+                .Width  = GuiResolveAxis(ChildInput->Size.Width , ChildInput->MinSize.Width , ChildInput->MaxSize.Width , ChildMeasure->IntrinsicSize.Width , ColumnSize[Column]),
+                .Height = GuiResolveAxis(ChildInput->Size.Height, ChildInput->MinSize.Height, ChildInput->MaxSize.Height, ChildMeasure->IntrinsicSize.Height, RowHeight),
+            };
+
+            gui_point Position =
+            {
+                .X = CursorX + GuiGetAlignmentOffset(Input->XAlign, ColumnSize[Column] - Size.Width) + ChildInput->AnimatedOffset.X,
+                .Y = CursorY + GuiGetAlignmentOffset(Input->YAlign, RowHeight - Size.Height)         + ChildInput->AnimatedOffset.Y,
+            };
+
+            if((Size.Width != ChildOutput->Size.Width) || (Size.Height != ChildOutput->Size.Height) ||
+               (Position.X != ChildOutput->Position.X) || (Position.Y != ChildOutput->Position.Y))
+            {
+                ChildOutput->Size     = Size;
+                ChildOutput->Position = Position;
+                Tree->States[Cells[Column]].Dirty |= Gui_LayoutDirty_Place | Gui_LayoutDirty_Moved;
+            }
+
+            CursorX += ColumnSize[Column] + Input->Spacing;
+        }
+
+        CursorY += RowHeight + Input->Spacing;
+        Row     += 1;
+    }
+}
+
+
+// Arrange runs top-down in depth-first order. The node's own size and position are
+// final when we get here, we resolve the size of each child against our content
+// bounds and place it. Children left dirty are visited next by the caller.
+
+static void
+GuiArrangeLayout(gui_layout_node *Node, gui_layout_tree *Tree, gui_layout_stats *Stats, uint32_t *StaleWraps)
+{
+    GUI_ASSERT(GuiIsValidLayoutNode(Node));
+    GUI_ASSERT(GuiIsValidLayoutTree(Tree));
+
+    gui_layout_input   *Input   = GuiGetLayoutInput(Node->Index, Tree);
+    gui_layout_output  *Output  = GuiGetLayoutOutput(Node->Index, Tree);
+    gui_layout_measure *Measure = GuiGetLayoutMeasure(Node->Index, Tree);
+
+    if(GuiGetLayoutGrid(Node->Index, Tree))
+    {
+        GuiArrangeGrid(Node, Tree);
+
+        Tree->States[Node->Index].Dirty &= Gui_LayoutDirty_Moved;
+
+        ++Stats->ArrangedCount;
+        return;
+    }
+
+    gui_dimensions ContentBounds = GuiGetContentBounds(Input, Output, Node->ChildCount);
+    gui_bool       IsWrapping    = GuiIsWrapping(Input);
+    gui_bool       IsFlex        = (Input->Direction == Gui_LayoutDirection_Horizontal || Input->Direction == Gui_LayoutDirection_Vertical) && !IsWrapping;
+    gui_flex_state Flex          = { .IsXMajor = (Input->Direction == Gui_LayoutDirection_Horizontal), .IsGrowing = GUI_TRUE, .Ratio = 0.0f };
+
+    // Stored lines are walked along with the children to make sure they still describe them.
+    gui_layout_wrap *Wrap          = Tree->Wraps + Node->Index;
+    gui_bool         AreLinesValid = IsWrapping;
+    uint32_t         LineRemaining = 0;
+
+    if(IsFlex)
+    {
+        GuiSolveFlex(Node, Tree, ContentBounds, &Flex);
+    }
+
+    Measure->ChildSize = (gui_dimensions){ .Width = 0.0f, .Height = 0.0f };
+
+    gui_layout_node *Child = GuiGetLayoutNode(Node->First, Tree);
+    while(GuiIsValidLayoutNode(Child))
+    {
+        uint32_t       Batch[GUI_SIZING_BATCH];
+        gui_dimensions Sizes[GUI_SIZING_BATCH];
+        uint32_t       BatchCount = 0;
+
+        for(; GuiIsValidLayoutNode(Child) && BatchCount < GUI_SIZING_BATCH; Child = GuiGetLayoutNode(Child->Next, Tree))
+        {
+            Batch[BatchCount++] = Child->Index;
+        }
+
+        GuiResolveChildSizes(Batch, BatchCount, ContentBounds, Sizes, Tree);
+
+        for(uint32_t Idx = 0; Idx < BatchCount; ++Idx)
+        {
+            gui_layout_output *ChildOutput = GuiGetLayoutOutput(Batch[Idx], Tree);
+            gui_dimensions     Size        = Sizes[Idx];
+
+            if(IsFlex && Flex.Ratio > 0.0f)
+            {
+                float FlexSize = GuiGetFlexSize(GuiGetLayoutInput(Batch[Idx], Tree), GuiGetLayoutMeasure(Batch[Idx], Tree), ContentBounds, &Flex, 0);
+                if(Flex.IsXMajor)
+                {
+                    Size.Width = FlexSize;
+                }
+                else
+                {
+                    Size.Height = FlexSize;
+                }
+            }
+
+            if((Size.Width != ChildOutput->Size.Width) || (Size.Height != ChildOutput->Size.Height))
+            {
+                ChildOutput->Size = Size;
+                Tree->States[Batch[Idx]].Dirty |= Gui_LayoutDirty_Place | Gui_LayoutDirty_Moved;
+                AreLinesValid = GUI_FALSE;
+            }
+
+            if(AreLinesValid && LineRemaining == 0)
+            {
+                gui_layout_wrap *Line = Tree->Wraps + Batch[Idx];
+
+                AreLinesValid = (Line->LineOwner == Node->Index && Line->LineStamp == Wrap->Stamp && Line->LineCount > 0);
+                LineRemaining = Line->LineCount;
+            }
+
+            LineRemaining             -= AreLinesValid ? 1 : 0;
+            Measure->ChildSize.Width  += ChildOutput->Size.Width;
+            Measure->ChildSize.Height += ChildOutput->Size.Height;
+        }
+    }
+
+    if(IsWrapping)
+    {
+        gui_bool IsXMajor  = (Input->Direction == Gui_LayoutDirection_Horizontal);
+        float    MajorSize = IsXMajor ? ContentBounds.Width : ContentBounds.Height;
+
+        if(!AreLinesValid || LineRemaining != 0 || Wrap->BreakSize != MajorSize)
+        {
+            Wrap->LinesSize = GuiBreakLines(Node, MajorSize, GUI_FALSE, Tree);
+            Wrap->BreakSize = MajorSize;
+        }
+
+        Measure->ChildSize.Width  = IsXMajor ? Wrap->LinesSize.Width  : Wrap->LinesSize.Height;
+        Measure->ChildSize.Height = IsXMajor ? Wrap->LinesSize.Height : Wrap->LinesSize.Width;
+
+        // A node that fits its lines was measured against a guess of its major size. If
+        // the guess broke the lines differently, it has to be measured again.
+        gui_sizing MinorSizing = IsXMajor ? Input->Size.Height : Input->Size.Width;
+        if(MinorSizing.Type == Gui_LayoutSizing_Fit && Wrap->LinesSize.Height != Wrap->MeasuredExtent)
+        {
+            if(!Wrap->IsStale)
+            {
+                Wrap->IsStale   = GUI_TRUE;
+                Wrap->NextStale = *StaleWraps;
+                *StaleWraps     = Node->Index;
+            }
+
+            ++Stats->WrapRemeasureCount;
+        }
+
+        GuiPlaceLines(Node, MajorSize, Tree);
+
+        Tree->States[Node->Index].Dirty &= Gui_LayoutDirty_Moved;
+
+        ++Stats->ArrangedCount;
+        return;
+    }
+
+    gui_point Cursor   = (gui_point){ .X = Output->Position.X + Input->Padding.Left - Input->ContentOffset.X, .Y = Output->Position.Y + Input->Padding.Top - Input->ContentOffset.Y };
+    gui_bool  IsXMajor = (Input->Direction == Gui_LayoutDirection_Horizontal);
+
+    float MajorSize = IsXMajor ? Output->Size.Width - (Input->Padding.Left + Input->Padding.Right) : Output->Size.Height - (Input->Padding.Top + Input->Padding.Bottom);
+    float MinorSize = IsXMajor ? Output->Size.Height - (Input->Padding.Top + Input->Padding.Bottom) : Output->Size.Width - (Input->Padding.Left + Input->Padding.Right);
+
+    Gui_Alignment MajorAlignment    = IsXMajor ? Input->XAlign : Input->YAlign;
+    float         MajorChildrenSize = IsXMajor ? Measure->ChildSize.Width : Measure->ChildSize.Height;
+    float         MajorOffset       = GuiGetAlignmentOffset(MajorAlignment, MajorSize - MajorChildrenSize);
+
+    if(IsXMajor)
+    {
+        Cursor.X += MajorOffset;
+    }
+    else
+    {
+        Cursor.Y += MajorOffset;
+    }
+
+    for(Child = GuiGetLayoutNode(Node->First, Tree); GuiIsValidLayoutNode(Child); Child = GuiGetLayoutNode(Child->Next, Tree))
+    {
+        gui_layout_input  *ChildInput  = GuiGetLayoutInput(Child->Index, Tree);
+        gui_layout_output *ChildOutput = GuiGetLayoutOutput(Child->Index, Tree);
+
+        gui_point Position = Cursor;
+        Gui_Alignment MinorAlign = IsXMajor ? Input->YAlign : Input->XAlign;
+        float MinorOffset = GuiGetAlignmentOffset(MinorAlign, IsXMajor ? (MinorSize - ChildOutput->Size.Height) : (MinorSize - ChildOutput->Size.Width));
+
+        if(IsXMajor)
+        {
+            Position.Y += MinorOffset;
+            Cursor.X   += ChildOutput->Size.Width + Input->Spacing;
+        }
+        else
+        {
+            Position.X += MinorOffset;
+            Cursor.Y   += ChildOutput->Size.Height + Input->Spacing;
+        }
+
+        Position.X += ChildInput->AnimatedOffset.X;
+        Position.Y += ChildInput->AnimatedOffset.Y;
+
+        if((Position.X != ChildOutput->Position.X) || (Position.Y != ChildOutput->Position.Y))
+        {
+            ChildOutput->Position = Position;
+            Tree->States[Child->Index].Dirty |= Gui_LayoutDirty_Place | Gui_LayoutDirty_Moved;
+        }
+    }
+
+    // Moved is left for the caller to journal, tasks cannot append to the journal.
+    Tree->States[Node->Index].Dirty &= Gui_LayoutDirty_Moved;
+
+    ++Stats->ArrangedCount;
+}
+
+
+// Two subtrees with the same inputs and the same size end up with the same layout
+// relative to their root. The cache maps that pair to the root's output of a subtree
+// laid out earlier, the template. On a hit the template's relative positions and
+// sizes are copied instead of arranging the subtree. Templates live in the tree
+// itself, so an entry is only trusted if the template still matches and is clean.
+
+static gui_bool
+GuiRestoreCachedLayout(uint32_t At, gui_layout_tree *Tree)
+{
+    gui_resource_table *Cache = Tree->LayoutCache;
+    gui_layout_node    *Node  = GuiGetDepthFirstNode(At, Tree);
+
+    if(!Cache || Node->ChildCount == 0)
+    {
+        return GUI_FALSE;
+    }
+
+    gui_layout_output  *Output  = GuiGetLayoutOutput(Node->Index, Tree);
+    gui_layout_measure *Measure = GuiGetLayoutMeasure(Node->Index, Tree);
+    gui_resource_key    Key     = { .Value = GuiMixLayoutFloat(GuiMixLayoutFloat(Measure->SubtreeHash, Output->Size.Width), Output->Size.Height) };
+    gui_resource_state  Entry   = GuiFindResourceByKey(Key, Cache);
+
+    gui_layout_output  *Template        = (Entry.ResourceType == Gui_ResourceType_LayoutSubtree) ? (gui_layout_output *)Entry.Resource : 0;
+    gui_layout_measure *TemplateMeasure = 0;
+    uint32_t            Count           = Tree->DepthFirstSize[At];
+    gui_bool            IsValid         = GUI_FALSE;
+    uint32_t            Source          = 0;
+
+    if(Template >= Tree->Outputs && Template < Tree->Outputs + Tree->NodeCapacity && Template != Output)
+    {
+        gui_layout_node *TemplateNode = GuiGetLayoutNode((uint32_t)(Template - Tree->Outputs), Tree);
+
+        TemplateMeasure = GuiGetLayoutMeasure(TemplateNode->Index, Tree);
+        Source          = TemplateNode->DepthFirstIndex;
+        IsValid         = GuiIsValidLayoutNode(TemplateNode)                              &&
+                          Source < Tree->DepthFirstCount                                  &&
+                          Tree->DepthFirst[Source]     == TemplateNode->Index             &&
+                          Tree->DepthFirstSize[Source] == Count                           &&
+                          Tree->States[TemplateNode->Index].Dirty == Gui_LayoutDirty_None &&
+                          TemplateMeasure->SubtreeHash == Measure->SubtreeHash            &&
+                          Template->Size.Width         == Output->Size.Width              &&
+                          Template->Size.Height        == Output->Size.Height;
+    }
+
+    if(!IsValid)
+    {
+        // The lookup counted a hit, but the template went stale.
+        if(Template)
+        {
+            --Cache->Stats.CacheHitCount;
+            ++Cache->Stats.CacheMissCount;
+        }
+
+        GuiUpdateResourceTable(Entry.Id, Key, Output, sizeof(gui_layout_output), Gui_ResourceType_LayoutSubtree, Cache);
+        return GUI_FALSE;
+    }
+
+    for(uint32_t Offset = 1; Offset < Count; ++Offset)
+    {
+        uint32_t           FromIndex = Tree->DepthFirst[Source + Offset];
+        uint32_t           ToIndex   = Tree->DepthFirst[At + Offset];
+        gui_layout_output *From      = GuiGetLayoutOutput(FromIndex, Tree);
+        gui_layout_output *To        = GuiGetLayoutOutput(ToIndex, Tree);
+
+        gui_point Position =
+        {
+            .X = Output->Position.X + (From->Position.X - Template->Position.X),
+            .Y = Output->Position.Y + (From->Position.Y - Template->Position.Y),
+        };
+
+        gui_bool IsMoved = (Position.X != To->Position.X) || (Position.Y != To->Position.Y) ||
+                           (From->Size.Width != To->Size.Width) || (From->Size.Height != To->Size.Height);
+
+        To->Position = Position;
+        To->Size     = From->Size;
+
+        Tree->Measures[ToIndex].ChildSize = Tree->Measures[FromIndex].ChildSize;
+        Tree->States[ToIndex].Dirty       = IsMoved ? Gui_LayoutDirty_Moved : Gui_LayoutDirty_None;
+        GuiJournalLayoutChange(ToIndex, Tree);
+    }
+
+    Measure->ChildSize = TemplateMeasure->ChildSize;
+    Tree->States[Node->Index].Dirty = Gui_LayoutDirty_None;
+
+    return GUI_TRUE;
+}
+
+
+// Once a node is placed, the subtrees of its children no longer depend on each
+// other. Nodes with more than TaskSize descendants form a spine that is processed
+// serially: after the tasks when measuring, before them when arranging. Runs of
+// smaller sibling subtrees hanging off the spine are packed into tasks of roughly
+// TaskSize nodes. Runs too small to be worth a dispatch stay on the spine.
+
+static void
+GuiUpdateLayoutTasks(gui_layout_tree *Tree)
+{
+    if(!Tree->AreTasksDirty)
+    {
+        return;
+    }
+
+    uint32_t Grain = Tree->Parallel.TaskSize ? Tree->Parallel.TaskSize : 1;
+    uint32_t Count = Tree->DepthFirstCount;
+    uint32_t At    = 0;
+
+    Tree->TaskCount = 0;
+
+    while(At < Count && Tree->TaskCount < GUI_MAX_LAYOUT_TASKS)
+    {
+        if(Tree->DepthFirstSize[At] > Grain)
+        {
+            At += 1;
+            continue;
+        }
+
+        uint32_t Begin  = At;
+        uint32_t End    = At + Tree->DepthFirstSize[At];
+        uint32_t Parent = GuiGetDepthFirstNode(At, Tree)->Parent;
+
+        while(End < Count && (End - Begin) < Grain && Tree->DepthFirstSize[End] <= Grain && GuiGetDepthFirstNode(End, Tree)->Parent == Parent)
+        {
+            End += Tree->DepthFirstSize[End];
+        }
+
+        if((End - Begin) * 4 >= Grain)
+        {
+            Tree->Tasks[Tree->TaskCount++] = (gui_layout_task){ .Begin = Begin, .End = End, .StaleWraps = GuiInvalidIndex };
+        }
+
+        At = End;
+    }
+
+    Tree->AreTasksDirty = GUI_FALSE;
+}
+
+
+// Measures the dirty nodes of [Begin, End) children first. A node with neither a
+// measure nor a descendant flag has a clean subtree, which is stepped over whole,
+// as are the given task ranges. Dirty nodes are pushed on the way down and measured
+// once the walk leaves their subtree. The stack never holds more nodes than the
+// range, so each range keeps it in its own slice of the depth-first scratch.
+
+static void
+GuiMeasureLayoutRange(uint32_t Begin, uint32_t End, gui_layout_task *Tasks, uint32_t TaskCount, gui_layout_stats *Stats, gui_layout_tree *Tree)
+{
+    uint32_t *Stack = Tree->DepthFirstScratch + Begin;
+    uint32_t  Depth = 0;
+    uint32_t  Task  = 0;
+    uint32_t  At    = Begin;
+
+    while(At < End || Depth > 0)
+    {
+        uint32_t Top = Depth > 0 ? Stack[Depth - 1] : 0;
+
+        if(Depth > 0 && (At >= End || Top + Tree->DepthFirstSize[Top] <= At))
+        {
+            GuiMeasureLayout(GuiGetDepthFirstNode(Top, Tree), Tree, Stats);
+            Depth -= 1;
+            continue;
+        }
+
+        while(Task < TaskCount && Tasks[Task].Begin < At)
+        {
+            Task += 1;
+        }
+
+        if(Task < TaskCount && At == Tasks[Task].Begin)
+        {
+            At    = Tasks[Task].End;
+            Task += 1;
+            continue;
+        }
+
+        if(Tree->States[Tree->DepthFirst[At]].Dirty & (Gui_LayoutDirty_Measure | Gui_LayoutDirty_Descendant))
+        {
+            Stack[Depth++] = At;
+            At += 1;
+        }
+        else
+        {
+            At += Tree->DepthFirstSize[At];
+        }
+    }
+}
+
+
+static void
+GuiMeasureLayoutTask(void *Data, uint32_t Index)
+{
+    gui_layout_tree *Tree = (gui_layout_tree *)Data;
+    gui_layout_task *Task = &Tree->Tasks[Index];
+
+    GuiMeasureLayoutRange(Task->Begin, Task->End, 0, 0, &Task->Stats, Tree);
+}
+
+
+static void
+GuiArrangeLayoutTask(void *Data, uint32_t Index)
+{
+    gui_layout_tree *Tree = (gui_layout_tree *)Data;
+    gui_layout_task *Task = &Tree->Tasks[Index];
+
+    uint32_t At = Task->Begin;
+    while(At < Task->End)
+    {
+        gui_layout_node *Node = GuiGetDepthFirstNode(At, Tree);
+        if(Tree->States[Node->Index].Dirty)
+        {
+            Task->HasMoved |= (Tree->States[Node->Index].Dirty & Gui_LayoutDirty_Moved) ? GUI_TRUE : GUI_FALSE;
+            GuiArrangeLayout(Node, Tree, &Task->Stats, &Task->StaleWraps);
+            At += 1;
+        }
+        else
+        {
+            At += Tree->DepthFirstSize[At];
+        }
+    }
+}
+
+
+// One measure pass and one arrange pass over the dirty parts of the tree.
+
+static void
+GuiRunLayoutPasses(gui_layout_node *ActiveRoot, gui_layout_tree *Tree)
+{
+    GuiUpdateDepthFirstOrder(Tree);
+
+    gui_layout_parallel_params *Parallel  = &Tree->Parallel;
+    uint32_t                    TaskCount = 0;
+
+    if(Parallel->ParallelFor && Tree->DepthFirstCount >= Parallel->MinTreeSize)
+    {
+        GuiUpdateLayoutTasks(Tree);
+        TaskCount = Tree->TaskCount;
+    }
+
+    // Subtrees first, then the spine bottom-up. Task ranges are skipped by the serial walk.
+
+    if(TaskCount > 0)
+    {
+        Parallel->ParallelFor(GuiMeasureLayoutTask, Tree, TaskCount, Parallel->UserData);
+    }
+
+    GuiMeasureLayoutRange(0, Tree->DepthFirstCount, Tree->Tasks, TaskCount, &Tree->Stats, Tree);
+
+    // The root has no parent to resolve against, percent sizes are relative to its last size.
+    gui_layout_input   *RootInput   = GuiGetLayoutInput(ActiveRoot->Index, Tree);
+    gui_layout_output  *RootOutput  = GuiGetLayoutOutput(ActiveRoot->Index, Tree);
+    gui_layout_measure *RootMeasure = GuiGetLayoutMeasure(ActiveRoot->Index, Tree);
+
+    gui_dimensions RootSize =
+    {
+        .Width  = GuiResolveAxis(RootInput->Size.Width , RootInput->MinSize.Width , RootInput->MaxSize.Width , RootMeasure->IntrinsicSize.Width , RootOutput->Size.Width),
+        .Height = GuiResolveAxis(RootInput->Size.Height, RootInput->MinSize.Height, RootInput->MaxSize.Height, RootMeasure->IntrinsicSize.Height, RootOutput->Size.Height),
+    };
+
+    if((RootSize.Width != RootOutput->Size.Width) || (RootSize.Height != RootOutput->Size.Height))
+    {
+        RootOutput->Size = RootSize;
+        Tree->States[ActiveRoot->Index].Dirty |= Gui_LayoutDirty_Moved;
+    }
+
+    // A node that did not move or resize and has nothing dirty below it
+    // keeps the layout computed in a previous frame, its whole subtree is skipped.
+
+    uint32_t Task = 0;
+    uint32_t At   = 0;
+    while(At < Tree->DepthFirstCount)
+    {
+        // Tasks inside a skipped subtree are clean, they only need to be stepped over.
+        while(Task < TaskCount && Tree->Tasks[Task].Begin < At)
+        {
+            Task += 1;
+        }
+
+        if(Task < TaskCount && At == Tree->Tasks[Task].Begin)
+        {
+            At    = Tree->Tasks[Task].End;
+            Task += 1;
+            continue;
+        }
+
+        gui_layout_node *Node = GuiGetDepthFirstNode(At, Tree);
+        GuiJournalLayoutChange(Node->Index, Tree);
+
+        if(!Tree->States[Node->Index].Dirty || GuiRestoreCachedLayout(At, Tree))
+        {
+            At += Tree->DepthFirstSize[At];
+        }
+        else
+        {
+            GuiArrangeLayout(Node, Tree, &Tree->Stats, &Tree->StaleWrapFirst);
+            At += 1;
+        }
+    }
+
+    if(TaskCount > 0)
+    {
+        Parallel->ParallelFor(GuiArrangeLayoutTask, Tree, TaskCount, Parallel->UserData);
+
+        for(uint32_t Idx = 0; Idx < TaskCount; ++Idx)
+        {
+            gui_layout_stats *Stats = &Tree->Tasks[Idx].Stats;
+
+            Tree->Stats.MeasuredCount      += Stats->MeasuredCount;
+            Tree->Stats.ArrangedCount      += Stats->ArrangedCount;
+            Tree->Stats.SizingCycleCount   += Stats->SizingCycleCount;
+            Tree->Stats.WrapRemeasureCount += Stats->WrapRemeasureCount;
+
+            *Stats = (gui_layout_stats){0};
+
+            for(uint32_t At = Tree->Tasks[Idx].Begin; Tree->Tasks[Idx].HasMoved && At < Tree->Tasks[Idx].End; ++At)
+            {
+                GuiJournalLayoutChange(Tree->DepthFirst[At], Tree);
+            }
+
+            Tree->Tasks[Idx].HasMoved = GUI_FALSE;
+
+            while(Tree->Tasks[Idx].StaleWraps != GuiInvalidIndex)
+            {
+                gui_layout_wrap *Wrap = Tree->Wraps + Tree->Tasks[Idx].StaleWraps;
+
+                Tree->Tasks[Idx].StaleWraps = Wrap->NextStale;
+                Wrap->NextStale             = Tree->StaleWrapFirst;
+                Tree->StaleWrapFirst        = (uint32_t)(Wrap - Tree->Wraps);
+            }
+        }
+    }
+}
+
+
+// Marking stops at a relayout boundary, so its ancestors never learn that something
+// below them changed and the full pass steps over it when measuring. Queued boundaries
+// are measured on their own before any pass arranges, deepest first so that a boundary
+// nested in another one is measured before it.
+
+static void
+GuiMeasureRelayoutBoundaries(gui_layout_tree *Tree)
+{
+    GuiUpdateDepthFirstOrder(Tree);
+
+    uint32_t Begins[GUI_MAX_RELAYOUT_ROOTS];
+    uint32_t BeginCount = 0;
+
+    for(uint32_t Idx = 0; Idx < Tree->RelayoutRootCount; ++Idx)
+    {
+        gui_layout_node *Boundary = GuiGetLayoutNode(Tree->RelayoutRoots[Idx], Tree);
+
+        if(!GuiIsValidLayoutNode(Boundary))
+        {
+            continue;
+        }
+
+        uint32_t Begin = Boundary->DepthFirstIndex;
+        if(Begin >= Tree->DepthFirstCount || Tree->DepthFirst[Begin] != Boundary->Index)
+        {
+            continue;
+        }
+
+        uint32_t At = BeginCount++;
+        for(; At > 0 && Begins[At - 1] < Begin; --At)
+        {
+            Begins[At] = Begins[At - 1];
+        }
+
+        Begins[At] = Begin;
+    }
+
+    for(uint32_t Idx = 0; Idx < BeginCount; ++Idx)
+    {
+        GuiMeasureLayoutRange(Begins[Idx], Begins[Idx] + Tree->DepthFirstSize[Begins[Idx]], 0, 0, &Tree->Stats, Tree);
+    }
+}
+
+
+// Each queued boundary is arranged on its own, over its range of the depth-first
+// order, once GuiMeasureRelayoutBoundaries measured it. Its size cannot change, but
+// its hash did: the hashes of its ancestors are recomputed so the layout cache never
+// trusts a stale one. Measuring leaves Place on the boundary, so one that is clean
+// here was arranged by the full pass after it was measured, and is not laid out
+// again. The full pass may have hashed its ancestors before it changed, so those are
+// rehashed either way.
+
+static void
+GuiRelayoutBoundaries(gui_layout_tree *Tree)
+{
+    GuiUpdateDepthFirstOrder(Tree);
+
+    for(uint32_t Idx = 0; Idx < Tree->RelayoutRootCount; ++Idx)
+    {
+        gui_layout_node *Boundary = GuiGetLayoutNode(Tree->RelayoutRoots[Idx], Tree);
+
+        if(!GuiIsValidLayoutNode(Boundary))
+        {
+            continue;
+        }
+
+        uint32_t Begin = Boundary->DepthFirstIndex;
+        if(Begin >= Tree->DepthFirstCount || Tree->DepthFirst[Begin] != Boundary->Index)
+        {
+            continue;
+        }
+
+        GUI_ASSERT(!(Tree->States[Boundary->Index].Dirty & (Gui_LayoutDirty_Measure | Gui_LayoutDirty_Descendant)));
+
+        if(Tree->States[Boundary->Index].Dirty != Gui_LayoutDirty_None)
+        {
+            uint32_t End = Begin + Tree->DepthFirstSize[Begin];
+            uint32_t At  = Begin;
+            while(At < End)
+            {
+                gui_layout_node *Node = GuiGetDepthFirstNode(At, Tree);
+                GuiJournalLayoutChange(Node->Index, Tree);
+
+                if(!Tree->States[Node->Index].Dirty || GuiRestoreCachedLayout(At, Tree))
+                {
+                    At += Tree->DepthFirstSize[At];
+                }
+                else
+                {
+                    GuiArrangeLayout(Node, Tree, &Tree->Stats, &Tree->StaleWrapFirst);
+                    At += 1;
+                }
+            }
+
+            ++Tree->Stats.BoundaryRelayoutCount;
+        }
+
+        for(gui_layout_node *Parent = GuiGetLayoutNode(Boundary->Parent, Tree); GuiIsValidLayoutNode(Parent); Parent = GuiGetLayoutNode(Parent->Parent, Tree))
+        {
+            Tree->Measures[Parent->Index].SubtreeHash = GuiHashLayoutNode(Parent, Tree);
+        }
+    }
+
+    Tree->RelayoutRootCount = 0;
+}
+
+
+static void
+GuiMarkStaleWraps(gui_bool Remeasure, gui_layout_tree *Tree)
+{
+    while(Tree->StaleWrapFirst != GuiInvalidIndex)
+    {
+        uint32_t         NodeIndex = Tree->StaleWrapFirst;
+        gui_layout_wrap *Wrap      = Tree->Wraps + NodeIndex;
+
+        Tree->StaleWrapFirst = Wrap->NextStale;
+        Wrap->IsStale        = GUI_FALSE;
+
+        if(Remeasure)
+        {
+            GuiMarkLayoutDirty(NodeIndex, Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place, Tree);
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// [SECTION] PUBLIC LAYOUT API
+// [DESCRIP] ...
+// [HISTORY]
+// : - 2026-10-18 The grid pool is sized from the node count and grows with the tree
+// : - 2026-10-18 GuiBuildVirtualList takes a fixed viewport from the declared size
+// : - 2026-10-17 GuiSetLayoutCache only takes tables that evict
+// : - 2026-10-17 A parentless node declared after the root was swept becomes the root
+// : - 2026-10-17 Entering a parent pushes its key as the seed of its children
+// : - 2026-10-17 Node counts no longer need to be powers of two
+// : - 2026-10-17 GuiCreateNodes, node declaration and property updates shared with it
+// : - 2026-10-17 Shared array layout for placement and growth, GuiGrowLayoutTree
+// : - 2026-10-17 Entry points taking a gui_node reject stale handles
+// : - 2026-10-17 Free list ends with an invalid index, GuiCreateNode touches the node
+// : - 2026-10-17 GuiCreateNode keeps child links, GuiLeaveParent closes the lists
+// : - 2026-10-17 Layout journal footprint, placement and GuiSetLayoutJournal
+// : - 2026-10-17 Queued relayout boundaries are laid out on their own
+// : - 2026-10-17 GuiBuildVirtualList
+// : - 2026-10-17 Wrapped nodes measured against a stale size get a second round
+// : - 2026-10-17 Grid track storage in the tree footprint
+// : - 2026-10-17 GuiSetLayoutCache
+// : - 2026-10-17 GuiSetLayoutParallelism
+// : - 2026-10-17 Footprint and placement of the split node arrays
+// : - 2026-01-11 Basic Implementation
+//-----------------------------------------------------------------------------
+
+
+// The node arrays are laid out the same way by the placement and by growth.
+
+static uint64_t
+GuiGetLayoutArraysEnd(uint32_t NodeCount, uint64_t Start)
+{
+    uint64_t NodesStart    = GUI_ALIGN_POW2(Start, GUI_ALIGN_OF(gui_layout_node));
+    uint64_t NodesEnd      = NodesStart + ((NodeCount + 1) * sizeof(gui_layout_node));
+
+    uint64_t InputsStart   = GUI_ALIGN_POW2(NodesEnd, GUI_ALIGN_OF(gui_layout_input));
+    uint64_t InputsEnd     = InputsStart + (NodeCount * sizeof(gui_layout_input));
+
+    uint64_t OutputsStart  = GUI_ALIGN_POW2(InputsEnd, GUI_ALIGN_OF(gui_layout_output));
+    uint64_t OutputsEnd    = OutputsStart + (NodeCount * sizeof(gui_layout_output));
+
+    uint64_t MeasuresStart = GUI_ALIGN_POW2(OutputsEnd, GUI_ALIGN_OF(gui_layout_measure));
+    uint64_t MeasuresEnd   = MeasuresStart + (NodeCount * sizeof(gui_layout_measure));
+
+    uint64_t StatesStart   = GUI_ALIGN_POW2(MeasuresEnd, GUI_ALIGN_OF(gui_layout_state));
+    uint64_t StatesEnd     = StatesStart + (NodeCount * sizeof(gui_layout_state));
+
+    uint64_t PaintStart    = GUI_ALIGN_POW2(StatesEnd, GUI_ALIGN_OF(gui_paint_properties));
+    uint64_t PaintEnd      = PaintStart + (NodeCount * sizeof(gui_paint_properties));
+
+    uint64_t RefCount      = GuiGetReferenceCapacity(NodeCount);
 
     uint64_t RefKeyStart   = GUI_ALIGN_POW2(PaintEnd, GUI_ALIGN_OF(uint64_t));
-    uint64_t RefKeyEnd     = RefKeyStart + (NodeCount * sizeof(uint64_t));
+    uint64_t RefKeyEnd     = RefKeyStart + (RefCount * sizeof(uint64_t));
+
+    uint64_t RefValueStart = GUI_ALIGN_POW2(RefKeyEnd, GUI_ALIGN_OF(uint32_t));
+    uint64_t RefValueEnd   = RefValueStart + (RefCount * sizeof(uint32_t));
+
+    uint64_t RefTagStart   = RefValueEnd;
+    uint64_t RefTagEnd     = RefTagStart + (RefCount * sizeof(uint8_t));
+
+    uint64_t DFStart       = GUI_ALIGN_POW2(RefTagEnd, GUI_ALIGN_OF(uint32_t));
+    uint64_t DFEnd         = DFStart + (NodeCount * sizeof(uint32_t));
+
+    uint64_t DFSizeStart   = GUI_ALIGN_POW2(DFEnd, GUI_ALIGN_OF(uint32_t));
+    uint64_t DFSizeEnd     = DFSizeStart + (NodeCount * sizeof(uint32_t));
+
+    uint64_t ScratchStart  = GUI_ALIGN_POW2(DFSizeEnd, GUI_ALIGN_OF(uint32_t));
+    uint64_t ScratchEnd    = ScratchStart + (NodeCount * sizeof(uint32_t));
+
+    uint64_t GridCount     = GuiGetGridCapacity(NodeCount);
+
+    uint64_t GridsStart    = GUI_ALIGN_POW2(ScratchEnd, GUI_ALIGN_OF(gui_layout_grid));
+    uint64_t GridsEnd      = GridsStart + (GridCount * sizeof(gui_layout_grid));
+
+    uint64_t WrapsStart    = GUI_ALIGN_POW2(GridsEnd, GUI_ALIGN_OF(gui_layout_wrap));
+    uint64_t WrapsEnd      = WrapsStart + (NodeCount * sizeof(gui_layout_wrap));
+
+    uint64_t RetainsStart  = GUI_ALIGN_POW2(WrapsEnd, GUI_ALIGN_OF(gui_layout_retain));
+    uint64_t RetainsEnd    = RetainsStart + (NodeCount * sizeof(gui_layout_retain));
+
+    return RetainsEnd;
+}
+
+
+static gui_bool
+GuiPushLayoutArrays(uint32_t NodeCount, gui_memory_region *Local, gui_layout_tree *Tree)
+{
+    gui_bool Result    = GUI_FALSE;
+    uint32_t RefCount  = GuiGetReferenceCapacity(NodeCount);
+    uint32_t GridCount = GuiGetGridCapacity(NodeCount);
+
+    // ORDER IS IMPORTANT!
+    gui_layout_node      *Nodes     = GuiPushArray(Local, gui_layout_node, NodeCount + 1);
+    gui_layout_input     *Inputs    = GuiPushArray(Local, gui_layout_input, NodeCount);
+    gui_layout_output    *Outputs   = GuiPushArray(Local, gui_layout_output, NodeCount);
+    gui_layout_measure   *Measures  = GuiPushArray(Local, gui_layout_measure, NodeCount);
+    gui_layout_state     *States    = GuiPushArray(Local, gui_layout_state, NodeCount);
+    gui_paint_properties *Paint     = GuiPushArray(Local, gui_paint_properties, NodeCount);
+    uint64_t             *RefKeys   = GuiPushArray(Local, uint64_t, RefCount);
+    uint32_t             *RefValues = GuiPushArray(Local, uint32_t, RefCount);
+    uint8_t              *RefTags   = GuiPushArray(Local, uint8_t, RefCount);
+    uint32_t             *DFOrder   = GuiPushArray(Local, uint32_t, NodeCount);
+    uint32_t             *DFSize    = GuiPushArray(Local, uint32_t, NodeCount);
+    uint32_t             *Scratch   = GuiPushArray(Local, uint32_t, NodeCount);
+    gui_layout_grid      *Grids     = GuiPushArray(Local, gui_layout_grid, GridCount);
+    gui_layout_wrap      *Wraps     = GuiPushArray(Local, gui_layout_wrap, NodeCount);
+    gui_layout_retain    *Retains   = GuiPushArray(Local, gui_layout_retain, NodeCount);
+
+    if(Nodes && Inputs && Outputs && Measures && States && Paint && RefKeys && RefValues && RefTags && DFOrder && DFSize && Scratch && Grids && Wraps && Retains)
+    {
+        Tree->Nodes           = Nodes;
+        Tree->Inputs          = Inputs;
+        Tree->Outputs         = Outputs;
+        Tree->Measures        = Measures;
+        Tree->States          = States;
+        Tree->PaintBuffer     = Paint;
+        Tree->RefKeys         = RefKeys;
+        Tree->RefValues       = RefValues;
+        Tree->RefTags         = RefTags;
+        Tree->RefGroupMask    = (RefCount / GUI_REFERENCE_GROUP_WIDTH) - 1;
+        Tree->RefDeletedCount = 0;
+
+        for(uint32_t Slot = 0; Slot < RefCount; ++Slot)
+        {
+            RefTags[Slot] = GuiReferenceEmpty;
+        }
+
+        Tree->DepthFirst        = DFOrder;
+        Tree->DepthFirstSize    = DFSize;
+        Tree->DepthFirstScratch = Scratch;
+        Tree->Wraps             = Wraps;
+        Tree->Retains           = Retains;
+        Tree->Grids             = Grids;
+        Tree->GridCapacity      = GridCount;
+        Tree->FreeGrid          = 0;
+
+        for(uint32_t Slot = 0; Slot < GridCount; ++Slot)
+        {
+            Grids[Slot].NextFree = (Slot + 1 < GridCount) ? Slot + 1 : GuiInvalidIndex;
+        }
+
+        Result = GUI_TRUE;
+    }
+
+    return Result;
+}
+
+
+// Slots [Begin, End) become free nodes, chained in front of the free list.
+
+static void
+GuiInitFreeLayoutNodes(uint32_t Begin, uint32_t End, gui_layout_tree *Tree)
+{
+    gui_layout_node *Sentinel = GuiGetSentinelNode(Tree);
+
+    for(uint32_t Idx = Begin; Idx < End; ++Idx)
+    {
+        gui_layout_node *Node = GuiGetLayoutNode(Idx, Tree);
+        GUI_ASSERT(Node);
+
+        Node->Index      = GuiInvalidIndex;
+        Node->First      = GuiInvalidIndex;
+        Node->Last       = GuiInvalidIndex;
+        Node->Parent     = GuiInvalidIndex;
+        Node->Prev       = GuiInvalidIndex;
+        Node->ChildCount = 0;
+        Node->Generation = 0;
+        Node->Next       = (Idx + 1 < End) ? (uint32_t)(Idx + 1) : Sentinel->Next;
+
+        Tree->PaintBuffer[Idx] = (gui_paint_properties){0};
+    }
+
+    if(Begin < End)
+    {
+        Sentinel->Next = Begin;
+    }
+}
+
 
-    uint64_t RefValueStart = GUI_ALIGN_POW2(RefKeyEnd, GUI_ALIGN_OF(uint32_t));
-    uint64_t RefValueEnd   = RefValueStart + (NodeCount * sizeof(uint32_t));
+GUI_API gui_memory_footprint
+GuiGetLayoutTreeFootprint(uint32_t NodeCount)
+{
+    uint64_t TreeEnd   = sizeof(gui_layout_tree);
+    uint64_t ArraysEnd = GuiGetLayoutArraysEnd(NodeCount, TreeEnd);
 
     gui_memory_footprint Result =
     {
-        .SizeInBytes = RefValueEnd,
+        .SizeInBytes = ArraysEnd,
         .Alignment   = GUI_ALIGN_OF(gui_layout_tree),
         .Lifetime    = Gui_MemoryAllocation_Persistent,
     };
@@ -1700,56 +4508,465 @@ GuiGetLayoutTreeFootprint(uint32_t NodeCount)
 GUI_API gui_layout_tree *
 GuiPlaceLayoutTreeInMemory(uint32_t NodeCount, gui_memory_block Block)
 {
-    gui_layout_tree  *Result = 0;
-    gui_memory_region Local  = GuiEnterMemoryRegion(Block);
+    gui_layout_tree  *Result = 0;
+    gui_memory_region Local  = GuiEnterMemoryRegion(Block);
+
+    if(GuiIsValidMemoryRegion(&Local))
+    {
+        // ORDER IS IMPORTANT!
+        gui_layout_tree *Tree = GuiPushStruct(&Local, gui_layout_tree);
+
+        if(Tree && GuiPushLayoutArrays(NodeCount, &Local, Tree))
+        {
+            Tree->NodeCount         = 0;
+            Tree->NodeCapacity      = NodeCount;
+            Tree->RootIndex         = GuiInvalidIndex;
+            Tree->CapturedNodeIndex = GuiInvalidIndex;
+            Tree->Parent            = 0;
+            Tree->Stats             = (gui_layout_stats){0};
+            Tree->Parallel          = (gui_layout_parallel_params){0};
+            Tree->LayoutCache       = 0;
+            Tree->Journal           = 0;
+            Tree->Front             = 0;
+            Tree->Grow              = 0;
+            Tree->GrowUserData      = 0;
+            Tree->TaskCount         = 0;
+            Tree->AreTasksDirty     = GUI_TRUE;
+            Tree->DepthFirstCount   = 0;
+            Tree->IsTopologyDirty   = GUI_TRUE;
+            Tree->RelayoutRootCount = 0;
+            Tree->FrameStamp        = 2;
+            Tree->TouchedFirst      = GuiInvalidIndex;
+            Tree->StaleFirst        = GuiInvalidIndex;
+            Tree->StaleWrapFirst    = GuiInvalidIndex;
+
+            gui_layout_node *Sentinel = GuiGetSentinelNode(Tree);
+            Sentinel->Next  = GuiInvalidIndex;
+            Sentinel->Index = GuiInvalidIndex;
+
+            GuiInitFreeLayoutNodes(0, NodeCount, Tree);
+
+            Result = Tree;
+        }
+    }
+
+    return Result;
+}
+
+
+GUI_API gui_memory_footprint
+GuiGetLayoutTreeGrowthFootprint(uint32_t NodeCount)
+{
+    gui_memory_footprint Result =
+    {
+        .SizeInBytes = GuiGetLayoutArraysEnd(NodeCount, 0),
+        .Alignment   = GUI_ALIGN_OF(gui_layout_tree),
+        .Lifetime    = Gui_MemoryAllocation_Persistent,
+    };
+
+    return Result;
+}
+
+
+// Every slot keeps its index, so nodes, handles and the depth-first order are
+// copied as they are. Only the reference map is rebuilt, it has more slots. Layout
+// cache entries point into the old outputs and are dropped as stale. A front buffer
+// that is too small is never detached here, the growth is refused instead.
+
+GUI_API gui_bool
+GuiGrowLayoutTree(uint32_t NodeCount, gui_memory_block Block, gui_layout_tree *Tree)
+{
+    gui_bool          Result = GUI_FALSE;
+    gui_memory_region Local  = GuiEnterMemoryRegion(Block);
+
+    if(GuiIsValidLayoutTree(Tree) && GuiIsValidMemoryRegion(&Local) && NodeCount > Tree->NodeCapacity &&
+       (!Tree->Front || Tree->Front->NodeCapacity >= NodeCount))
+    {
+        gui_layout_tree Old      = *Tree;
+        uint32_t        Capacity = Tree->NodeCapacity;
+
+        if(GuiPushLayoutArrays(NodeCount, &Local, Tree))
+        {
+            for(uint32_t Idx = 0; Idx < Capacity; ++Idx)
+            {
+                Tree->Nodes[Idx]       = Old.Nodes[Idx];
+                Tree->Inputs[Idx]      = Old.Inputs[Idx];
+                Tree->Outputs[Idx]     = Old.Outputs[Idx];
+                Tree->Measures[Idx]    = Old.Measures[Idx];
+                Tree->States[Idx]      = Old.States[Idx];
+                Tree->PaintBuffer[Idx] = Old.PaintBuffer[Idx];
+                Tree->Wraps[Idx]       = Old.Wraps[Idx];
+                Tree->Retains[Idx]     = Old.Retains[Idx];
+            }
+
+            // The new grid slots are chained in front of the old free ones.
+            for(uint32_t Slot = 0; Slot < Old.GridCapacity; ++Slot)
+            {
+                Tree->Grids[Slot] = Old.Grids[Slot];
+            }
+
+            if(Tree->GridCapacity > Old.GridCapacity)
+            {
+                Tree->Grids[Tree->GridCapacity - 1].NextFree = Old.FreeGrid;
+                Tree->FreeGrid                               = Old.GridCapacity;
+            }
+            else
+            {
+                Tree->FreeGrid = Old.FreeGrid;
+            }
+
+            for(uint32_t At = 0; At < Old.DepthFirstCount; ++At)
+            {
+                Tree->DepthFirst[At]     = Old.DepthFirst[At];
+                Tree->DepthFirstSize[At] = Old.DepthFirstSize[At];
+            }
+
+            Tree->NodeCapacity     = NodeCount;
+            Tree->Nodes[NodeCount] = Old.Nodes[Capacity];
+
+            GuiInitFreeLayoutNodes(Capacity, NodeCount, Tree);
+            GuiRebuildNodeReferences(Tree);
+
+            Result = GUI_TRUE;
+        }
+    }
+
+    return Result;
+}
+
+
+GUI_API void
+GuiSetLayoutTreeGrowth(gui_grow_tree_proc *Grow, void *UserData, gui_layout_tree *Tree)
+{
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        Tree->Grow         = Grow;
+        Tree->GrowUserData = UserData;
+    }
+}
+
+
+// Declares a node for this frame: finds or allocates it, and appends it to the
+// parent being built.
+
+static gui_layout_node *
+GuiDeclareLayoutNode(uint64_t Key, uint32_t Flags, uint32_t ParentIndex, gui_layout_tree *Tree)
+{
+    uint32_t FoundIndex = GuiFindNodeReference(Key, Tree);
+    if(FoundIndex == GuiInvalidIndex)
+    {
+        gui_layout_node *Node = GuiGetFreeLayoutNode(Tree);
+        if(Node)
+        {
+            GuiInsertNodeReference(Key, Node->Index, Tree);
+            Tree->Retains[Node->Index].Key = Key;
+
+            FoundIndex = Node->Index;
+        }
+    }
+
+    gui_layout_node *Node = GuiGetLayoutNode(FoundIndex, Tree);
+    if(GuiIsValidLayoutNode(Node))
+    {
+        GuiTouchLayoutNode(Node->Index, Tree);
+
+        Node->LastChildCount = Node->ChildCount;
+        Node->ChildCount     = 0;
+        Node->Last           = GuiInvalidIndex;
+
+        Tree->States[Node->Index].Flags = Flags;
+
+        GuiAppendLayoutNode(ParentIndex, Node->Index, Tree);
+
+        // The first node becomes the root, as does the first parentless one declared
+        // after the root was swept.
+
+        if ((Tree->NodeCount == 1 || (Tree->RootIndex == GuiInvalidIndex && ParentIndex == GuiInvalidIndex)) && Tree->RootIndex != Node->Index)
+        {
+            Tree->RootIndex       = Node->Index;
+            Tree->IsTopologyDirty = GUI_TRUE;
+        }
+    }
+    else
+    {
+        Node = 0;
+    }
+
+    return Node;
+}
+
+
+// Tracks are only read for grids, and are already normalized by the caller. Taking
+// a grid slot can grow the tree, node pointers held across the call go stale.
+
+static void
+GuiApplyLayoutProperties(uint32_t NodeIndex, gui_layout_properties *Properties, gui_grid_tracks *Tracks, gui_layout_tree *Tree)
+{
+    gui_layout_grid *Grid       = GuiGetLayoutGrid(NodeIndex, Tree);
+    gui_bool         IsSameGrid = GUI_TRUE;
+
+    if(Properties->Direction == Gui_LayoutDirection_Grid && !Grid)
+    {
+        Grid       = GuiAcquireLayoutGrid(NodeIndex, Tree);
+        IsSameGrid = (Grid == 0);
+    }
+    else if(Properties->Direction != Gui_LayoutDirection_Grid && Grid)
+    {
+        GuiReleaseLayoutGrid(NodeIndex, Tree);
+        Grid = 0;
+    }
+
+    if(Grid && !GuiIsSameGridTracks(&Grid->Tracks, Tracks))
+    {
+        Grid->Tracks = *Tracks;
+        IsSameGrid   = GUI_FALSE;
+    }
+
+    gui_layout_input *Input = GuiGetLayoutInput(NodeIndex, Tree);
+
+    if(!IsSameGrid || !GuiIsSameLayoutInput(Input, Properties))
+    {
+        GuiMarkLayoutDirty(NodeIndex, Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place, Tree);
+
+        Input->Size      = Properties->Size;
+        Input->MinSize   = Properties->MinSize;
+        Input->MaxSize   = Properties->MaxSize;
+        Input->Direction = Properties->Direction;
+        Input->XAlign    = Properties->XAlign;
+        Input->YAlign    = Properties->YAlign;
+        Input->Padding   = Properties->Padding;
+        Input->Spacing   = Properties->Spacing;
+        Input->Grow      = Properties->Grow;
+        Input->Shrink    = Properties->Shrink;
+        Input->Wrap      = Properties->Wrap;
+
+        // if(!Cached->Layout.MinSize.IsSet)
+        // {
+            // Node->MinSize = Node->Size;
+        // }
+
+        // if(!Cached->Layout.MaxSize.IsSet)
+        // {
+            // Node->MaxSize = Node->Size;
+        // }
+    }
+}
+
+
+GUI_API gui_node
+GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
+{
+    gui_node Result = {.Value = GuiInvalidIndex};
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        uint32_t         ParentIndex = (Tree->Parent) ? Tree->Parent->Value : (uint32_t)GuiInvalidIndex;
+        gui_layout_node *Node        = GuiDeclareLayoutNode(Key, Flags, ParentIndex, Tree);
+
+        if(Node)
+        {
+            Result.Value      = Node->Index;
+            Result.Generation = Node->Generation;
+            Result.Tree       = Tree;
+        }
+    }
+
+    return Result;
+}
+
+
+// Declares Count leaf nodes under the parent being built, in order, and gives
+// them all the same layout and paint properties, either of which can be null.
+// Checks, the parent and the grid tracks are resolved once for the whole run.
+// Handles are written to Nodes when it is not null. Returns how many nodes were
+// declared, fewer than Count when the tree ran out of nodes.
+
+GUI_API uint32_t
+GuiCreateNodes(uint64_t *Keys, uint32_t Count, uint32_t Flags, gui_layout_properties *Layout, gui_paint_properties *Paint, gui_node *Nodes, gui_layout_tree *Tree)
+{
+    uint32_t Result = 0;
+
+    if(GuiIsValidLayoutTree(Tree) && Keys)
+    {
+        uint32_t        ParentIndex = (Tree->Parent) ? Tree->Parent->Value : (uint32_t)GuiInvalidIndex;
+        gui_grid_tracks Tracks      = {0};
+
+        if(Layout && Layout->Direction == Gui_LayoutDirection_Grid)
+        {
+            Tracks = GuiGetGridTracks(&Layout->Grid);
+        }
+
+        for(; Result < Count; ++Result)
+        {
+            gui_layout_node *Node = GuiDeclareLayoutNode(Keys[Result], Flags, ParentIndex, Tree);
+            if(!Node)
+            {
+                break;
+            }
+
+            gui_node Handle = { .Value = Node->Index, .Generation = Node->Generation, .Tree = Tree };
+
+            if(Layout)
+            {
+                GuiApplyLayoutProperties(Handle.Value, Layout, &Tracks, Tree);
+            }
+
+            if(Paint)
+            {
+                Tree->PaintBuffer[Handle.Value] = *Paint;
+            }
+
+            if(Nodes)
+            {
+                Nodes[Result] = Handle;
+            }
+        }
+    }
+
+    return Result;
+}
+
+
+GUI_API void
+GuiUpdateLayout(gui_node Node, gui_layout_properties *Properties, gui_layout_tree *Tree)
+{
+    if(GuiIsValidLayoutTree(Tree) && Properties)
+    {
+        gui_layout_node *LayoutNode = GuiGetLayoutNodeFromHandle(Node, Tree);
+
+        if(GuiIsValidLayoutNode(LayoutNode))
+        {
+            gui_grid_tracks Tracks = {0};
+
+            if(Properties->Direction == Gui_LayoutDirection_Grid)
+            {
+                Tracks = GuiGetGridTracks(&Properties->Grid);
+            }
+
+            GuiApplyLayoutProperties(LayoutNode->Index, Properties, &Tracks, Tree);
+        }
+    }
+}
+
+
+// The finalizer maps zero to zero, so the root seed must not be zero or the first
+// child of the root would share its key with its own first child.
+
+static uint64_t
+GuiGetParentSeed(gui_layout_tree *Tree)
+{
+    uint64_t Result = Tree->Parent ? Tree->Parent->Seed : 0x9E3779B97F4A7C15ull;
+    return Result;
+}
+
+
+GUI_API gui_bool
+GuiEnterParent(gui_node Node, gui_layout_tree *Tree, gui_parent_node *ParentNode)
+{
+    if(GuiIsValidLayoutTree(Tree) && ParentNode)
+    {
+        gui_layout_node *LayoutNode = GuiGetLayoutNodeFromHandle(Node, Tree);
+        uint64_t         Seed       = GuiGetParentSeed(Tree);
+
+        ParentNode->Prev  = Tree->Parent;
+        ParentNode->Value = GuiIsValidLayoutNode(LayoutNode) ? LayoutNode->Index : (uint32_t)GuiInvalidIndex;
+        ParentNode->Seed  = GuiIsValidLayoutNode(LayoutNode) ? Tree->Retains[LayoutNode->Index].Key : Seed;
+
+        Tree->Parent = ParentNode;
+    }
+
+    return GUI_TRUE;
+}
+
+
+GUI_API void
+GuiLeaveParent(gui_node Node, gui_layout_tree *Tree)
+{
+    GUI_UNUSED(Node.Value);
+
+    if(GuiIsValidLayoutTree(Tree) && Tree->Parent)
+    {
+        gui_layout_node *Parent = GuiGetLayoutNode(Tree->Parent->Value, Tree);
+        if(GuiIsValidLayoutNode(Parent))
+        {
+            gui_layout_node *Last = GuiGetLayoutNode(Parent->Last, Tree);
+            if(GuiIsValidLayoutNode(Last))
+            {
+                GuiCloseChildList(Last, Tree);
+            }
+
+            GuiCloseChildList(Parent, Tree);
+        }
+
+        Tree->Parent = Tree->Parent->Prev;
+    }
+}
+
+
+// The local key is spread by an odd multiply before it is mixed with the parent's
+// seed, so a parent and local key swapped between two nodes do not give the same
+// child key, as they would with a plain xor.
+
+GUI_API uint64_t
+GuiGetChildKey(uint64_t LocalKey, gui_layout_tree *Tree)
+{
+    uint64_t Result = 0;
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        Result = GuiHashNodeReference(GuiGetParentSeed(Tree) ^ ((LocalKey + 1) * 0x9E3779B97F4A7C15ull));
+    }
+
+    return Result;
+}
+
+
+GUI_API gui_bool
+GuiAppendChild(uint32_t ParentIndex, uint32_t ChildIndex, gui_layout_tree *Tree)
+{
+    gui_bool Result = GUI_FALSE;
+
+    if(GuiIsValidLayoutTree(Tree) && ParentIndex != ChildIndex)
+    {
+        GuiAppendLayoutNode(ParentIndex, ChildIndex, Tree);
+        Result = GUI_TRUE;
+    }
+
+    return Result;
+}
+
+
+GUI_API uint32_t
+GuiFindChild(gui_node Node, uint32_t FindIndex, gui_layout_tree *Tree)
+{
+    uint32_t Result = (uint32_t)GuiInvalidIndex;
 
-    if(GuiIsValidMemoryRegion(&Local))
+    if(GuiIsValidLayoutTree(Tree))
     {
-        // ORDER IS IMPORTANT!
-        gui_layout_tree      *Tree      = GuiPushStruct(&Local, gui_layout_tree);
-        gui_layout_node      *Nodes     = GuiPushArray(&Local, gui_layout_node, NodeCount + 1);
-        gui_paint_properties *Paint     = GuiPushArray(&Local, gui_paint_properties, NodeCount);
-        uint64_t             *RefKeys   = GuiPushArray(&Local, uint64_t, NodeCount);
-        uint32_t             *RefValues = GuiPushArray(&Local, uint32_t, NodeCount);
-
-        if(Nodes && Paint && Tree && RefKeys && RefValues)
+        gui_layout_node *LayoutNode = GuiGetLayoutNodeFromHandle(Node, Tree);
+        if(GuiIsValidLayoutNode(LayoutNode))
         {
-            Tree->Nodes             = Nodes;
-            Tree->NodeCount         = 0;
-            Tree->NodeCapacity      = NodeCount;
-            Tree->PaintBuffer       = Paint;
-            Tree->RefKeys           = RefKeys;
-            Tree->RefValues         = RefValues;
-            Tree->RootIndex         = GuiInvalidIndex;
-            Tree->CapturedNodeIndex = GuiInvalidIndex;
-            Tree->Parent            = 0;
-            Tree->RefHashMask       = NodeCount - 1;
+            gui_layout_node *Child = GuiGetLayoutNode(LayoutNode->First, Tree);
 
-            for(uint32_t Idx = 0; Idx < NodeCount; ++Idx)
+            // While the node is being built, the links past its last appended
+            // child are last frame's.
+
+            if(FindIndex >= LayoutNode->ChildCount)
             {
-                Tree->RefKeys[Idx]   = GuiInvalidIndex;
-                Tree->RefValues[Idx] = GuiInvalidIndex;
+                Child = 0;
             }
 
-            for(uint32_t Idx = 0; Idx < Tree->NodeCapacity; ++Idx)
+            uint32_t Remaining = FindIndex;
+            while(GuiIsValidLayoutNode(Child) && Remaining)
             {
-                gui_layout_node *Node = GuiGetLayoutNode(Idx, Tree);
-                GUI_ASSERT(Node);
-
-                Node->Index      = GuiInvalidIndex;
-                Node->First      = GuiInvalidIndex;
-                Node->Last       = GuiInvalidIndex;
-                Node->Parent     = GuiInvalidIndex;
-                Node->Prev       = GuiInvalidIndex;
-                Node->ChildCount = 0;
-                Node->Next       = (uint32_t)(Idx + 1);
+                Child      = GuiGetLayoutNode(Child->Next, Tree);
+                Remaining -= 1;
             }
 
-            gui_layout_node *Sentinel = GuiGetSentinelNode(Tree);
-            Sentinel->Next  = 0;
-            Sentinel->Index = GuiInvalidIndex;
-
-            Result = Tree;
+            if(GuiIsValidLayoutNode(Child))
+            {
+                Result = Child->Index;
+            }
         }
     }
 
@@ -1757,41 +4974,83 @@ GuiPlaceLayoutTreeInMemory(uint32_t NodeCount, gui_memory_block Block)
 }
 
 
-GUI_API gui_node
-GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
+// Row N always lands in slot N % SlotCount, where SlotCount is the number of rows
+// that fit in the viewport plus one for the row cut at each end. The rows on screen
+// never share a slot, and a slot's node and children are reused by the next row
+// scrolled into it. The scroll offset within the first row becomes the list's
+// content offset.
+
+GUI_API uint32_t
+GuiBuildVirtualList(gui_node Node, gui_virtual_list_params Params, gui_layout_tree *Tree)
 {
-    gui_node Result = {.Value = GuiInvalidIndex};
+    uint32_t Result = 0;
 
-    if(GuiIsValidLayoutTree(Tree))
+    if(GuiIsValidLayoutTree(Tree) && Params.BuildRow && Params.RowHeight > 0.0f)
     {
-        uint32_t FoundIndex = GuiFindNodeReference(Key, Tree);
-        if(FoundIndex == GuiInvalidIndex)
+        gui_layout_node *List = GuiGetLayoutNodeFromHandle(Node, Tree);
+        if(GuiIsValidLayoutNode(List))
         {
-            gui_layout_node *Node = GuiGetFreeLayoutNode(Tree);
-            if(Node)
+            gui_layout_input  *Input    = GuiGetLayoutInput(List->Index, Tree);
+            gui_layout_output *Output   = GuiGetLayoutOutput(List->Index, Tree);
+            gui_bool           IsXMajor = (Input->Direction == Gui_LayoutDirection_Horizontal);
+
+            // A fixed size is known before the list is laid out, anything else is taken
+            // from its last arranged size.
+            gui_sizing Size    = IsXMajor ? Input->Size.Width    : Input->Size.Height;
+            gui_sizing MinSize = IsXMajor ? Input->MinSize.Width : Input->MinSize.Height;
+            gui_sizing MaxSize = IsXMajor ? Input->MaxSize.Width : Input->MaxSize.Height;
+            float      Extent  = IsXMajor ? Output->Size.Width   : Output->Size.Height;
+
+            if(Size.Type == Gui_LayoutSizing_Fixed)
             {
-                GuiInsertNodeReference(Key, Node->Index, Tree);
-
-                FoundIndex = Node->Index;
+                Extent = GuiMeasureAxis(Size, MinSize, MaxSize, 0.0f);
             }
-        }
 
-        gui_layout_node *Node = GuiGetLayoutNode(FoundIndex, Tree);
-        if(GuiIsValidLayoutNode(Node))
-        {
-            Node->ChildCount = 0;
-            Node->Flags      = Flags;
+            float Padding  = IsXMajor ? Input->Padding.Left + Input->Padding.Right : Input->Padding.Top + Input->Padding.Bottom;
+            float Viewport = fmaxf(Extent - Padding, 0.0f);
+            float Pitch    = Params.RowHeight + Input->Spacing;
+            float Content  = (float)Params.RowCount * Pitch - Input->Spacing;
+            float Offset   = fminf(fmaxf(Params.ScrollOffset, 0.0f), fmaxf(Content - Viewport, 0.0f));
+
+            uint32_t SlotCount = (uint32_t)ceilf(Viewport / Pitch) + 1;
+            uint32_t First     = (uint32_t)(Offset / Pitch);
+            uint32_t Last      = (First + SlotCount < Params.RowCount) ? First + SlotCount : Params.RowCount;
+
+            gui_direction ContentOffset =
+            {
+                .X = IsXMajor ? Offset - (float)First * Pitch : 0.0f,
+                .Y = IsXMajor ? 0.0f : Offset - (float)First * Pitch,
+            };
+
+            if(ContentOffset.X != Input->ContentOffset.X || ContentOffset.Y != Input->ContentOffset.Y)
+            {
+                // The offset is part of the list's layout hash, so it is measured again too.
+                Input->ContentOffset = ContentOffset;
+                GuiMarkLayoutDirty(List->Index, Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place, Tree);
+            }
 
-            uint32_t ParentIndex = (Tree->Parent) ? Tree->Parent->Value : (uint32_t)GuiInvalidIndex;
-            GuiAppendLayoutNode(ParentIndex, Node->Index, Tree);
+            gui_parent_node ListParent;
 
-            Result.Value = Node->Index;
-            Result.Tree  = Tree;
+            GuiEnterParent(Node, Tree, &ListParent);
 
-            if (Tree->NodeCount == 1)
+            for(uint32_t Row = First; Row < Last; ++Row)
             {
-                Tree->RootIndex = Node->Index;
+                uint64_t Key     = GuiGetChildKey(Row % SlotCount, Tree);
+                gui_node RowNode = GuiCreateNode(Key, Gui_NodeFlags_None, Tree);
+
+                if(RowNode.Value != GuiInvalidIndex)
+                {
+                    gui_parent_node RowParent;
+
+                    GuiEnterParent(RowNode, Tree, &RowParent);
+                    Params.BuildRow((gui_virtual_row){ .Index = Row, .Key = Key, .Node = RowNode }, Params.UserData);
+                    GuiLeaveParent(RowNode, Tree);
+
+                    Result += 1;
+                }
             }
+
+            GuiLeaveParent(Node, Tree);
         }
     }
 
@@ -1800,101 +5059,135 @@ GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
 
 
 GUI_API void
-GuiUpdateLayout(gui_node Node, gui_layout_properties *Properties, gui_layout_tree *Tree)
+GuiComputeTreeLayout(gui_layout_tree *Tree)
 {
-    if(GuiIsValidLayoutTree(Tree) && Properties)
+    if(GuiIsValidLayoutTree(Tree))
     {
-        gui_layout_node *LayoutNode = GuiGetLayoutNode(Node.Value, Tree);
-        if(GuiIsValidLayoutNode(LayoutNode))
+        gui_layout_node *ActiveRoot = GuiGetLayoutNode(Tree->RootIndex, Tree);
+
+        // Nodes on the last path of the tree are closed here when the caller
+        // did not leave them.
+
+        for(gui_layout_node *Node = ActiveRoot; GuiIsValidLayoutNode(Node); Node = GuiGetLayoutNode(Node->Last, Tree))
+        {
+            GuiCloseChildList(Node, Tree);
+        }
+
+        // A wrapping node that was measured against a bad guess of its size is
+        // measured once more, the second round only walks the dirty paths.
+
+        for(uint32_t Round = 0; Round < 2 && GuiIsValidLayoutNode(ActiveRoot); ++Round)
         {
-            LayoutNode->Size      = Properties->Size;
-            LayoutNode->MinSize   = Properties->MinSize;
-            LayoutNode->MaxSize   = Properties->MaxSize;
-            LayoutNode->Direction = Properties->Direction;
-            LayoutNode->XAlign    = Properties->XAlign;
-            LayoutNode->YAlign    = Properties->YAlign;
-            LayoutNode->Padding   = Properties->Padding;
-            LayoutNode->Spacing   = Properties->Spacing;
+            gui_bool IsRootDirty = (Tree->States[ActiveRoot->Index].Dirty != Gui_LayoutDirty_None);
+            if(!IsRootDirty && Tree->RelayoutRootCount == 0)
+            {
+                break;
+            }
+
+            uint64_t StaleCount = Tree->Stats.WrapRemeasureCount;
+
+            GuiMeasureRelayoutBoundaries(Tree);
+
+            if(IsRootDirty)
+            {
+                GuiRunLayoutPasses(ActiveRoot, Tree);
+            }
 
-            // if(!Cached->Layout.MinSize.IsSet)
-            // {
-                // Node->MinSize = Node->Size;
-            // }
+            GuiRelayoutBoundaries(Tree);
+
+            if(Tree->Stats.WrapRemeasureCount == StaleCount)
+            {
+                break;
+            }
 
-            // if(!Cached->Layout.MaxSize.IsSet)
-            // {
-                // Node->MaxSize = Node->Size;
-            // }
+            GuiMarkStaleWraps(Round == 0, Tree);
         }
     }
 }
 
 
-GUI_API gui_bool
-GuiEnterParent(gui_node Node, gui_layout_tree *Tree, gui_parent_node *ParentNode)
+// The cache adds an entry for every distinct subtree it sees, so it only accepts
+// tables placed with EvictLeastRecent.
+
+GUI_API void
+GuiSetLayoutCache(gui_resource_table *Table, gui_layout_tree *Tree)
 {
-    if(GuiIsValidLayoutTree(Tree) && ParentNode)
+    if(GuiIsValidLayoutTree(Tree) && (!Table || Table->EvictLeastRecent))
     {
-        ParentNode->Prev  = Tree->Parent;
-        ParentNode->Value = Node.Value;
-
-        Tree->Parent = ParentNode;
+        Tree->LayoutCache = Table;
     }
-
-    return GUI_TRUE;
 }
 
 
 GUI_API void
-GuiLeaveParent(gui_node Node, gui_layout_tree *Tree)
+GuiSetLayoutParallelism(gui_layout_parallel_params Params, gui_layout_tree *Tree)
 {
-    GUI_UNUSED(Node.Value);
-
-    if(GuiIsValidLayoutTree(Tree) && Tree->Parent)
+    if(GuiIsValidLayoutTree(Tree))
     {
-        Tree->Parent = Tree->Parent->Prev;
+        Tree->Parallel      = Params;
+        Tree->AreTasksDirty = GUI_TRUE;
     }
 }
 
 
-GUI_API gui_bool
-GuiAppendChild(uint32_t ParentIndex, uint32_t ChildIndex, gui_layout_tree *Tree)
+GUI_API gui_layout_stats
+GuiGetLayoutStats(gui_bool ClearStats, gui_layout_tree *Tree)
 {
-    gui_bool Result = GUI_FALSE;
+    gui_layout_stats Result = {0};
 
-    if(GuiIsValidLayoutTree(Tree) && ParentIndex != ChildIndex)
+    if(GuiIsValidLayoutTree(Tree))
     {
-        GuiAppendLayoutNode(ParentIndex, ChildIndex, Tree);
-        Result = GUI_TRUE;
+        Result = Tree->Stats;
+
+        if(ClearStats)
+        {
+            Tree->Stats = (gui_layout_stats){0};
+        }
     }
 
     return Result;
 }
 
 
-GUI_API uint32_t
-GuiFindChild(gui_node Node, uint32_t FindIndex, gui_layout_tree *Tree)
+GUI_API gui_memory_footprint
+GuiGetLayoutJournalFootprint(uint32_t Capacity)
 {
-    uint32_t Result = (uint32_t)GuiInvalidIndex;
+    uint64_t JournalEnd = sizeof(gui_layout_journal);
 
-    if(GuiIsValidLayoutTree(Tree))
+    uint64_t NodesStart = GUI_ALIGN_POW2(JournalEnd, GUI_ALIGN_OF(uint32_t));
+    uint64_t NodesEnd   = NodesStart + (Capacity * sizeof(uint32_t));
+
+    gui_memory_footprint Result =
     {
-        gui_layout_node *LayoutNode = GuiGetLayoutNode(Node.Value, Tree);
-        if(GuiIsValidLayoutNode(LayoutNode))
-        {
-            gui_layout_node *Child = GuiGetLayoutNode(LayoutNode->First, Tree);
+        .SizeInBytes = NodesEnd,
+        .Alignment   = GUI_ALIGN_OF(gui_layout_journal),
+        .Lifetime    = Gui_MemoryAllocation_Transient,
+    };
 
-            uint32_t Remaining = FindIndex;
-            while(GuiIsValidLayoutNode(Child) && Remaining)
-            {
-                Child      = GuiGetLayoutNode(Child->Next, Tree);
-                Remaining -= 1;
-            }
+    return Result;
+}
 
-            if(GuiIsValidLayoutNode(Child))
-            {
-                Result = Child->Index;
-            }
+
+GUI_API gui_layout_journal *
+GuiPlaceLayoutJournalInMemory(uint32_t Capacity, gui_memory_block Block)
+{
+    gui_layout_journal *Result = 0;
+    gui_memory_region   Local  = GuiEnterMemoryRegion(Block);
+
+    if(GuiIsValidMemoryRegion(&Local))
+    {
+        // ORDER IS IMPORTANT!
+        gui_layout_journal *Journal = GuiPushStruct(&Local, gui_layout_journal);
+        uint32_t           *Nodes   = GuiPushArray(&Local, uint32_t, Capacity);
+
+        if(Journal && Nodes)
+        {
+            Journal->Nodes      = Nodes;
+            Journal->Count      = 0;
+            Journal->Capacity   = Capacity;
+            Journal->IsComplete = GUI_TRUE;
+
+            Result = Journal;
         }
     }
 
@@ -1903,20 +5196,11 @@ GuiFindChild(gui_node Node, uint32_t FindIndex, gui_layout_tree *Tree)
 
 
 GUI_API void
-GuiComputeTreeLayout(gui_layout_tree *Tree)
+GuiSetLayoutJournal(gui_layout_journal *Journal, gui_layout_tree *Tree)
 {
     if(GuiIsValidLayoutTree(Tree))
     {
-        gui_layout_node *ActiveRoot = GuiGetLayoutNode(Tree->RootIndex, Tree);
-
-        while(GUI_TRUE)
-        {
-            gui_bool Changed = GUI_FALSE;
-            GuiComputeLayout(ActiveRoot, Tree, ActiveRoot->OutputSize, 0, &Changed);
-            if(!Changed) break;
-        }
-
-        GuiPlaceLayout(ActiveRoot, Tree, 0);
+        Tree->Journal = Journal;
     }
 }
 
@@ -2056,6 +5340,7 @@ GuiUpdateAnimation(gui_position_animation *Animation, float Delta)
 // [SECTION] Animation Public API Implementation
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 GuiAnimatePosition rejects stale handles
 // : - 2026-01-15 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -2066,7 +5351,7 @@ GuiAnimatePosition(gui_node Node, uint32_t Slot, gui_direction Offset, float Dur
     gui_layout_tree *Tree      = Node.Tree;
     uint32_t         NodeIndex = Node.Value;
 
-    if(GuiIsValidLayoutTree(Tree))
+    if(GuiIsValidLayoutTree(Tree) && GuiIsValidLayoutNode(GuiGetLayoutNodeFromHandle(Node, Tree)))
     {
         // Let's do some linear search on the existing allocations
         // Animation order doesn't matter, so we can assume that they are always
@@ -2113,48 +5398,129 @@ GuiAnimatePosition(gui_node Node, uint32_t Slot, gui_direction Offset, float Dur
 // [SECTION] GUI PAINTING INTERNAL HELPERS
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 Per-node command helpers, front buffer publishing
+// : - 2026-10-17 Counting walks the depth-first order
 // : - 2026-01-12 Basic Implementation
 //-----------------------------------------------------------------------------
 
 
+static gui_paint_style *
+GuiGetActivePaintStyle(uint32_t NodeIndex, gui_layout_tree *Tree)
+{
+    gui_paint_style *Result = &Tree->PaintBuffer[NodeIndex].Default;
+    uint32_t         State  = Tree->States[NodeIndex].State;
+
+    if (State & Gui_NodeState_UseFocusedStyle)
+    {
+        Result = &Tree->PaintBuffer[NodeIndex].Focused;
+    }
+    else if (State & Gui_NodeState_UseHoveredStyle)
+    {
+        Result = &Tree->PaintBuffer[NodeIndex].Hovered;
+    }
+
+    return Result;
+}
+
+
 static uint32_t
-GuiCountCommandForTree(uint32_t NodeIndex, gui_layout_tree *Tree)
+GuiCountCommandForStyle(gui_paint_style *Style)
 {
     uint32_t Count = 0;
 
-    gui_layout_node *Node = GuiGetLayoutNode(NodeIndex, Tree);
-    GUI_ASSERT(Node);
+    if (Style->Color.A > 0.0f)
+    {
+        ++Count;
+    }
+
+    if (Style->BorderWidth > 0.0f)
+    {
+        ++Count;
+    }
+
+    return Count;
+}
 
-    gui_paint_style *Style = &Tree->PaintBuffer[Node->Index].Default;
 
-    if (Node->State & Gui_NodeState_UseFocusedStyle)
+static uint32_t
+GuiCountCommandForTree(gui_layout_tree *Tree)
+{
+    uint32_t          Count = 0;
+    gui_front_buffer *Front = Tree->Front;
+
+    if (Front)
     {
-        Style = &Tree->PaintBuffer[Node->Index].Focused;
+        for (uint32_t At = 0; At < Front->OrderCount; ++At)
+        {
+            Count += GuiCountCommandForStyle(&Front->Styles[At]);
+        }
     }
-    else if (Node->State & Gui_NodeState_UseHoveredStyle)
+    else
     {
-        Style = &Tree->PaintBuffer[Node->Index].Hovered;
+        GuiUpdateDepthFirstOrder(Tree);
+
+        for (uint32_t At = 0; At < Tree->DepthFirstCount; ++At)
+        {
+            Count += GuiCountCommandForStyle(GuiGetActivePaintStyle(Tree->DepthFirst[At], Tree));
+        }
     }
 
-    gui_color Color       = Style->Color;
-    float     BorderWidth = Style->BorderWidth;
+    return Count;
+}
+
 
-    if (Color.A > 0.0f)
+static uint32_t
+GuiPushCommandsForNode(gui_bounding_box Box, gui_paint_style *Style, gui_render_command *Commands, uint32_t CommandCount, uint32_t MaxCount)
+{
+    if (Style->Color.A > 0.0f && CommandCount < MaxCount)
     {
-        ++Count;
+        gui_render_command *Command = &Commands[CommandCount++];
+
+        Command->Type = Gui_RenderCommandType_Rectangle;
+        Command->Box  = Box;
+
+        Command->Rect.Color        = Style->Color;
+        Command->Rect.CornerRadius = Style->CornerRadius;
     }
 
-    if (BorderWidth > 0.0f)
+    if (Style->BorderWidth > 0.0f && CommandCount < MaxCount)
     {
-        ++Count;
+        gui_render_command *Command = &Commands[CommandCount++];
+
+        Command->Type = Gui_RenderCommandType_Border;
+        Command->Box  = Box;
+
+        Command->Border.Color        = Style->BorderColor;
+        Command->Border.CornerRadius = Style->CornerRadius;
+        Command->Border.Width        = Style->BorderWidth;
     }
 
-    for (uint32_t Child = Node->First; Child != GuiInvalidIndex; Child = GuiGetLayoutNode(Child, Tree)->Next)
+    return CommandCount;
+}
+
+
+// Called by GuiBeginFrame before any node state is reset, so the styles are the
+// ones the last frame was built with. The caller's render thread must be done
+// with the previous contents.
+
+static void
+GuiPublishFrontBuffer(gui_layout_tree *Tree)
+{
+    gui_front_buffer *Front = Tree->Front;
+
+    GuiUpdateDepthFirstOrder(Tree);
+
+    for (uint32_t At = 0; At < Tree->DepthFirstCount; ++At)
     {
-        Count += GuiCountCommandForTree(Child, Tree);
+        uint32_t NodeIndex = Tree->DepthFirst[At];
+
+        Front->Boxes[NodeIndex] = GuiGetLayoutNodeBoundingBox(GuiGetLayoutOutput(NodeIndex, Tree));
+        Front->Order[At]        = NodeIndex;
+        Front->Styles[At]       = *GuiGetActivePaintStyle(NodeIndex, Tree);
     }
 
-    return Count;
+    Front->OrderCount  = Tree->DepthFirstCount;
+    Front->FrameIndex += 1;
 }
 
 
@@ -2162,6 +5528,9 @@ GuiCountCommandForTree(uint32_t NodeIndex, gui_layout_tree *Tree)
 // [SECTION] GUI PAINTING API IMPLEMENTATION
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 GuiUpdateStyle rejects stale handles
+// : - 2026-10-17 Paint from the front buffer when one is attached
+// : - 2026-10-17 Paint in depth-first order, dropped the BFS queue
 // : - 2026-01-12 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -2184,7 +5553,7 @@ GuiColorFromRGB8(uint8_t R, uint8_t G, uint8_t B, uint8_t A)
 GUI_API void
 GuiUpdateStyle(gui_node Node, gui_paint_properties *Properties, gui_layout_tree *Tree)
 {
-    if (GuiIsValidLayoutTree(Tree) && Properties)
+    if (GuiIsValidLayoutTree(Tree) && Properties && GuiIsValidLayoutNode(GuiGetLayoutNodeFromHandle(Node, Tree)))
     {
         gui_paint_properties *Resolved = &Tree->PaintBuffer[Node.Value];
 
@@ -2211,7 +5580,7 @@ GuiGetRenderCommandCount(gui_render_command_params Params, gui_layout_tree *Tree
 {
     GUI_UNUSED(Params);
 
-    uint32_t Result = GuiCountCommandForTree(Tree->RootIndex, Tree);
+    uint32_t Result = GuiCountCommandForTree(Tree);
     return Result;
 }
 
@@ -2221,14 +5590,11 @@ GuiGetRenderCommandsFootprint(gui_render_command_params Params, gui_layout_tree
 {
     gui_memory_footprint Result = {0};
 
-    if (GuiIsValidLayoutTree(Tree))
+    if (Tree && (Tree->Front || GuiIsValidLayoutTree(Tree)))
     {
         uint64_t CommandEnd = (Params.Count + 1) * sizeof(gui_render_command);
 
-        uint64_t QueueStart = CommandEnd + GUI_ALIGN_POW2(CommandEnd, GUI_ALIGN_OF(uint64_t));
-        uint64_t QueueEnd   = QueueStart + Tree->NodeCount * sizeof(uint32_t);
-
-        Result.SizeInBytes = QueueEnd;
+        Result.SizeInBytes = CommandEnd;
         Result.Alignment   = GUI_ALIGN_OF(gui_render_command);
         Result.Lifetime    = Gui_MemoryAllocation_Transient;
     }
@@ -2243,67 +5609,38 @@ GuiComputeRenderCommands(gui_render_command_params Params, gui_layout_tree *Tree
     gui_render_command *Result = 0;
     gui_memory_region   Local  = GuiEnterMemoryRegion(Block);
 
-    if (GuiIsValidLayoutTree(Tree) && GuiIsValidMemoryRegion(&Local))
+    // With a front buffer, the tree itself is being built by another thread and
+    // must not be read.
+
+    if (Tree && (Tree->Front || GuiIsValidLayoutTree(Tree)) && GuiIsValidMemoryRegion(&Local))
     {
-        gui_render_command *Commands  = GuiPushArray(&Local, gui_render_command, Params.Count);
-        uint32_t           *NodeQueue = GuiPushArray(&Local, uint32_t, Tree->NodeCount);
+        gui_render_command *Commands = GuiPushArray(&Local, gui_render_command, Params.Count + 1);
 
-        if(Commands && NodeQueue)
+        if(Commands)
         {
-            uint32_t CommandCount = 0;
-            uint32_t Head         = 0;
-            uint32_t Tail         = 0;
-            
-            NodeQueue[Tail++] = Tree->RootIndex;
-            
-            while (Head < Tail && CommandCount < Params.Count)
+            uint32_t          CommandCount = 0;
+            gui_front_buffer *Front        = Tree->Front;
+
+            // Pre-order paints every parent before its children, and a later
+            // sibling's subtree over an earlier one.
+
+            if (Front)
             {
-                uint32_t         NodeIndex = NodeQueue[Head++];
-                gui_layout_node *Node      = GuiGetLayoutNode(NodeIndex, Tree);
-                GUI_ASSERT(Node);
-            
-                for (uint32_t Child = Node->First; Child != GuiInvalidIndex; Child = GuiGetLayoutNode(Child, Tree)->Next)
-                {
-                    NodeQueue[Tail++] = Child;
-                }
-            
-                gui_paint_style *Style = &Tree->PaintBuffer[Node->Index].Default;
-            
-                if (Node->State & Gui_NodeState_UseFocusedStyle)
-                {
-                    Style = &Tree->PaintBuffer[Node->Index].Focused;
-                }
-                else if (Node->State & Gui_NodeState_UseHoveredStyle)
+                for (uint32_t At = 0; At < Front->OrderCount && CommandCount < Params.Count; ++At)
                 {
-                    Style = &Tree->PaintBuffer[Node->Index].Hovered;
+                    gui_bounding_box Box = Front->Boxes[Front->Order[At]];
+                    CommandCount = GuiPushCommandsForNode(Box, &Front->Styles[At], Commands, CommandCount, Params.Count);
                 }
+            }
+            else
+            {
+                GuiUpdateDepthFirstOrder(Tree);
 
-                gui_color         Color        = Style->Color;
-                gui_color         BorderColor  = Style->BorderColor;
-                float             BorderWidth  = Style->BorderWidth;
-                gui_corner_radius CornerRadius = Style->CornerRadius;
-            
-                if (Color.A > 0.0f)
-                {
-                    gui_render_command *Command = &Commands[CommandCount++];
-            
-                    Command->Type = Gui_RenderCommandType_Rectangle;
-                    Command->Box  = GuiGetLayoutNodeBoundingBox(Node);
-            
-                    Command->Rect.Color        = Color;
-                    Command->Rect.CornerRadius = CornerRadius;
-                }
-            
-                if (BorderWidth > 0.0f)
+                for (uint32_t At = 0; At < Tree->DepthFirstCount && CommandCount < Params.Count; ++At)
                 {
-                    gui_render_command *Command = &Commands[CommandCount++];
-            
-                    Command->Type = Gui_RenderCommandType_Border;
-                    Command->Box  = GuiGetLayoutNodeBoundingBox(Node);
-            
-                    Command->Border.Color        = BorderColor;
-                    Command->Border.CornerRadius = CornerRadius;
-                    Command->Border.Width        = BorderWidth;
+                    uint32_t         NodeIndex = Tree->DepthFirst[At];
+                    gui_bounding_box Box       = GuiGetLayoutNodeBoundingBox(GuiGetLayoutOutput(NodeIndex, Tree));
+                    CommandCount = GuiPushCommandsForNode(Box, GuiGetActivePaintStyle(NodeIndex, Tree), Commands, CommandCount, Params.Count);
                 }
             }
 
@@ -2317,10 +5654,79 @@ GuiComputeRenderCommands(gui_render_command_params Params, gui_layout_tree *Tree
 }
 
 
+GUI_API gui_memory_footprint
+GuiGetFrontBufferFootprint(uint32_t NodeCount)
+{
+    uint64_t BufferEnd   = sizeof(gui_front_buffer);
+
+    uint64_t BoxesStart  = GUI_ALIGN_POW2(BufferEnd, GUI_ALIGN_OF(gui_bounding_box));
+    uint64_t BoxesEnd    = BoxesStart + (NodeCount * sizeof(gui_bounding_box));
+
+    uint64_t OrderStart  = GUI_ALIGN_POW2(BoxesEnd, GUI_ALIGN_OF(uint32_t));
+    uint64_t OrderEnd    = OrderStart + (NodeCount * sizeof(uint32_t));
+
+    uint64_t StylesStart = GUI_ALIGN_POW2(OrderEnd, GUI_ALIGN_OF(gui_paint_style));
+    uint64_t StylesEnd   = StylesStart + (NodeCount * sizeof(gui_paint_style));
+
+    gui_memory_footprint Result =
+    {
+        .SizeInBytes = StylesEnd,
+        .Alignment   = GUI_ALIGN_OF(gui_front_buffer),
+        .Lifetime    = Gui_MemoryAllocation_Persistent,
+    };
+
+    return Result;
+}
+
+
+GUI_API gui_front_buffer *
+GuiPlaceFrontBufferInMemory(uint32_t NodeCount, gui_memory_block Block)
+{
+    gui_front_buffer  *Result = 0;
+    gui_memory_region  Local  = GuiEnterMemoryRegion(Block);
+
+    if(GuiIsValidMemoryRegion(&Local))
+    {
+        // ORDER IS IMPORTANT!
+        gui_front_buffer *Buffer = GuiPushStruct(&Local, gui_front_buffer);
+        gui_bounding_box *Boxes  = GuiPushArray(&Local, gui_bounding_box, NodeCount);
+        uint32_t         *Order  = GuiPushArray(&Local, uint32_t, NodeCount);
+        gui_paint_style  *Styles = GuiPushArray(&Local, gui_paint_style, NodeCount);
+
+        if(Buffer && Boxes && Order && Styles)
+        {
+            Buffer->Boxes        = Boxes;
+            Buffer->Order        = Order;
+            Buffer->Styles       = Styles;
+            Buffer->OrderCount   = 0;
+            Buffer->NodeCapacity = NodeCount;
+            Buffer->FrameIndex   = 0;
+
+            Result = Buffer;
+        }
+    }
+
+    return Result;
+}
+
+
+GUI_API void
+GuiSetFrontBuffer(gui_front_buffer *Buffer, gui_layout_tree *Tree)
+{
+    if(GuiIsValidLayoutTree(Tree) && (!Buffer || Buffer->NodeCapacity >= Tree->NodeCapacity))
+    {
+        Tree->Front = Buffer;
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // [SECTION] GUI CONTEXT API IMPLEMENTATION
 // [DESCRIP] ...
 // [HISTORY]
+// : - 2026-10-17 GuiBeginFrame sweeps when the root is gone
+// : - 2026-10-17 GuiBeginFrame sweeps the nodes that were not declared
+// : - 2026-10-17 GuiBeginFrame publishes the front buffer
 // : - 2026-01-11 Basic Implementation
 //-----------------------------------------------------------------------------
 
@@ -2330,21 +5736,36 @@ GUI_API void
 GuiBeginFrame(gui_pointer_event_list *EventList, gui_layout_tree *Tree)
 {
     // Temporary barrier
-    if (!GuiIsValidLayoutTree(Tree) || Tree->RootIndex == GuiInvalidIndex)
+    if (!GuiIsValidLayoutTree(Tree))
     {
         GuiClearPointerEvents(EventList);
         return;
     }
 
-    for (uint32_t NodeIdx = 0; NodeIdx < Tree->NodeCapacity; ++NodeIdx)
+    // The journal lives in last frame's transient memory.
+    Tree->Journal = 0;
+
+    if (Tree->Front)
     {
-        gui_layout_node *Node = GuiGetLayoutNode(NodeIdx, Tree);
-        GUI_ASSERT(Node);
+        GuiPublishFrontBuffer(Tree);
+    }
+
+    // Sweeps even without a root: the root may be gone while other nodes are not,
+    // and those still have to be freed.
+    GuiSweepLayoutNodes(Tree);
+
+    if (Tree->RootIndex == GuiInvalidIndex)
+    {
+        GuiClearPointerEvents(EventList);
+        return;
+    }
 
+    for (uint32_t NodeIdx = 0; NodeIdx < Tree->NodeCapacity; ++NodeIdx)
+    {
         // This might be dangerous, maybe do not clear all of the state, but as much as we can.
         // Maybe even separate state into two groups -> Transient and Persistent
-        Node->State          = 0;
-        Node->AnimatedOffset = (gui_direction){0.f, 0.f};
+        Tree->States[NodeIdx].State          = 0;
+        Tree->Inputs[NodeIdx].AnimatedOffset = (gui_direction){0.f, 0.f};
     }
 
     // Obviously this is temporary. Unsure how I want to structure this yet. Who should own this?
@@ -2375,7 +5796,7 @@ GuiBeginFrame(gui_pointer_event_list *EventList, gui_layout_tree *Tree)
         {
             gui_pointer_state *State = &PointerStates[0];
             State->ButtonMask |= Event.ButtonMask;
-            State->IsCaptured  = GuiHandlePointerClick(State->Position, State->ButtonMask, 0, Tree);
+            State->IsCaptured  = GuiHandlePointerClick(State->Position, State->ButtonMask, Tree);
         } break;
 
         case Gui_PointerEvent_Release:
@@ -2385,7 +5806,7 @@ GuiBeginFrame(gui_pointer_event_list *EventList, gui_layout_tree *Tree)
 
             if(State->IsCaptured)
             {
-                GuiHandlePointerRelease(State->Position, State->ButtonMask, 0, Tree);
+                GuiHandlePointerRelease(State->Position, State->ButtonMask, Tree);
                 State->IsCaptured = GUI_FALSE;
             }
         } break;
@@ -2407,7 +5828,7 @@ GuiBeginFrame(gui_pointer_event_list *EventList, gui_layout_tree *Tree)
 
         if(State.ButtonMask == Gui_PointerButton_None) 
         {
-            GuiHandlePointerHover(State.Position, Tree->RootIndex, Tree);
+            GuiHandlePointerHover(State.Position, Tree);
         }
     }
 
@@ -2417,15 +5838,23 @@ GuiBeginFrame(gui_pointer_event_list *EventList, gui_layout_tree *Tree)
     for(uint32_t AnimationIdx = 0; AnimationIdx < Tree->AnimationCount; ++AnimationIdx)
     {
         gui_position_animation *Animation = &Tree->Animations[AnimationIdx];
+        gui_bool                WasActive = (Animation->State != Gui_Animation_Idle);
 
         // TODO: Inline this.
         GuiUpdateAnimation(Animation, DeltaTime);
 
-        gui_layout_node *Node = GuiGetLayoutNode(Animation->NodeTarget, Tree);
-        if(Node)
+        gui_layout_input *Input = GuiGetLayoutInput(Animation->NodeTarget, Tree);
+        if(Input)
         {
-            Node->AnimatedOffset.X += Animation->CurrentOffset.X;
-            Node->AnimatedOffset.Y += Animation->CurrentOffset.Y;
+            Input->AnimatedOffset.X += Animation->CurrentOffset.X;
+            Input->AnimatedOffset.Y += Animation->CurrentOffset.Y;
+
+            // Idle animations hold their offset, only moving ones need a new placement.
+            // The offset is part of the node's layout hash, so it is measured again too.
+            if(WasActive)
+            {
+                GuiMarkLayoutDirty(Animation->NodeTarget, Gui_LayoutDirty_Measure | Gui_LayoutDirty_Place, Tree);
+            }
         }
     }
 
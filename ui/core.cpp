@@ -27,6 +27,14 @@ GuiHashByteString(gui_byte_string Input)
 }
 
 
+static uint64_t
+GuiHashKeyString(gui_byte_string Input)
+{
+    uint64_t Result = GuiHashKeyBytes(Input.String, Input.Size);
+    return Result;
+}
+
+
 // =============================================================================
 // DOMAIN: Resource Cache
 // =============================================================================
@@ -547,12 +555,17 @@ GuiCreateContext(void)
 // Component stuff
 
 
+// Keys are local to the pushed parent, so the same name or index can be reused
+// under different parents. Prefer GuiCreateComponentWithKey on hot paths like
+// rows, it takes an index or a gui_key_lit and hashes no string. A name passed
+// to GuiCreateComponent maps to the same node as gui_key_lit of that name.
+
 static gui_component
-GuiCreateComponent(gui_byte_string Name, uint32_t Flags, gui_cached_style *Style, gui_layout_tree *Tree)
+GuiCreateComponentWithKey(uint64_t LocalKey, uint32_t Flags, gui_cached_style *Style, gui_layout_tree *Tree)
 {
     gui_component Component = 
     {
-        .LayoutIndex = GuiCreateNode(GuiHashByteString(Name), Flags, Tree),
+        .LayoutIndex = GuiCreateNode(GuiGetChildKey(LocalKey, Tree), Flags, Tree),
         .LayoutTree  = Tree,
     };
 
@@ -562,6 +575,14 @@ GuiCreateComponent(gui_byte_string Name, uint32_t Flags, gui_cached_style *Style
 }
 
 
+static gui_component
+GuiCreateComponent(gui_byte_string Name, uint32_t Flags, gui_cached_style *Style, gui_layout_tree *Tree)
+{
+    gui_component Component = GuiCreateComponentWithKey(GuiHashKeyString(Name), Flags, Style, Tree);
+    return Component;
+}
+
+
 static void
 GuiSetStyle(gui_component *Component, gui_cached_style *Style)
 {
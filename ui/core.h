@@ -79,6 +79,36 @@ static gui_bool        GuiIsValidByteString(gui_byte_string Input);
 static uint64_t        GuiHashByteString(gui_byte_string Input);
 
 
+// Node keys built from names use 64-bit FNV-1a instead of XXH3. It is a plain loop,
+// so the same function hashes literals at compile time through gui_key_lit and
+// dynamic names at runtime through GuiHashKeyString, and both give the same key.
+
+static constexpr uint64_t
+GuiHashKeyBytes(const char *String, uint64_t Size)
+{
+    uint64_t Result = 0xCBF29CE484222325ull;
+
+    for(uint64_t Idx = 0; Idx < Size; ++Idx)
+    {
+        Result ^= (uint8_t)String[Idx];
+        Result *= 0x00000100000001B3ull;
+    }
+
+    return Result;
+}
+
+static consteval uint64_t
+GuiHashKeyLiteral(const char *String, uint64_t Size)
+{
+    uint64_t Result = GuiHashKeyBytes(String, Size);
+    return Result;
+}
+
+#define gui_key_lit(String) GuiHashKeyLiteral((String), sizeof(String) - 1)
+
+static uint64_t        GuiHashKeyString(gui_byte_string Input);
+
+
 // =============================================================================
 // DOMAIN: Memory
 // =============================================================================
@@ -282,7 +312,8 @@ typedef struct gui_component
 } gui_component;
 
 
-static gui_component GuiCreateComponent  (gui_byte_string Name, uint32_t Flags, gui_cached_style *Style, gui_layout_tree *Tree);
+static gui_component GuiCreateComponent        (gui_byte_string Name, uint32_t Flags, gui_cached_style *Style, gui_layout_tree *Tree);
+static gui_component GuiCreateComponentWithKey (uint64_t LocalKey, uint32_t Flags, gui_cached_style *Style, gui_layout_tree *Tree);
 
 static void     GuiSetStyle              (gui_component *Component, gui_cached_style *Style);
 static gui_bool GuiPushComponent         (gui_component *Component, gui_parent_node *ParentNode);
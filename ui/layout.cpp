@@ -65,6 +65,7 @@ typedef struct gui_layout_node
     uint32_t            Prev;
     uint32_t            ChildCount;
     uint32_t            Index;
+    uint64_t            Key;
 
     gui_point           OutputPosition;
     gui_dimensions      OutputSize;
@@ -92,6 +93,7 @@ typedef struct gui_parent_node
 {
     gui_parent_node *Prev;
     uint32_t Value;
+    uint64_t Seed;
 } gui_parent_node;
 
 
@@ -103,9 +105,22 @@ typedef struct gui_node_buffer
 } gui_node_buffer;
 
 
+// Maps node keys to node indices. Each tree owns its map, so trees never share keys
+// and can be built on different threads. The map has at least twice as many slots
+// as the tree has nodes, it never fills up. A slot is empty when its value is invalid.
+
+typedef struct gui_key_map
+{
+    uint64_t *Keys;
+    uint32_t *Values;
+    uint64_t  Capacity;
+} gui_key_map;
+
+
 typedef struct gui_layout_tree
 {
     gui_node_buffer       NodeBuffer;
+    gui_key_map           KeyMap;
     gui_paint_properties *PaintBuffer;
     uint64_t              RootIndex;
     uint64_t              CapturedNodeIndex;
@@ -114,100 +129,61 @@ typedef struct gui_layout_tree
 
 
 // -----------------------------------------------------------------------------
-// Simple KeyMap replacement (TODO: Actually rewrite this)
+// Key map helpers
 // -----------------------------------------------------------------------------
 
 
-#define KEYMAP_CAPACITY 8192u
-#define KEYMAP_EMPTY ((uint64_t)0xFFFFFFFFFFFFFFFFULL)
-
-static uint64_t KeyMap_Keys[KEYMAP_CAPACITY];
-static uint32_t KeyMap_Values[KEYMAP_CAPACITY];
-static gui_bool KeyMap_Initialized = GUI_FALSE;
-
-static void
-GuiKeyMap_Init(void)
+static uint64_t
+GuiGetKeyMapCapacity(uint64_t NodeCount)
 {
-    if(!KeyMap_Initialized)
+    uint64_t Result = 16;
+    while(Result < 2 * NodeCount)
     {
-        for(uint32_t i = 0; i < KEYMAP_CAPACITY; ++i)
-        {
-            KeyMap_Keys[i] = KEYMAP_EMPTY;
-            KeyMap_Values[i] = (uint32_t)GuiInvalidIndex;
-        }
-        KeyMap_Initialized = GUI_TRUE;
+        Result <<= 1;
     }
+    return Result;
 }
 
-static uint32_t
-GuiKeyMap_FindOrInsert(uint64_t Key, gui_bool *Inserted)
+static void
+GuiKeyMap_Insert(uint64_t Key, uint32_t Value, gui_key_map *Map)
 {
-    // Returns value if found, otherwise inserts and returns GuiInvalidIndex
-    GuiKeyMap_Init();
-
-    uint32_t Hash = (uint32_t)(XXH3_64bits(&Key, sizeof(Key)) & (KEYMAP_CAPACITY - 1));
-    uint32_t Slot = Hash;
+    uint64_t Mask = Map->Capacity - 1;
+    uint64_t Slot = XXH3_64bits(&Key, sizeof(Key)) & Mask;
 
-    for(;;)
+    for(uint64_t Probe = 0; Probe < Map->Capacity; ++Probe)
     {
-        uint64_t Stored = KeyMap_Keys[Slot];
-        if(Stored == Key)
+        if(Map->Values[Slot] == GuiInvalidIndex || Map->Keys[Slot] == Key)
         {
-            if(Inserted) *Inserted = GUI_FALSE;
-            return KeyMap_Values[Slot];
-        }
-        if(Stored == KEYMAP_EMPTY)
-        {
-            // Insert
-            KeyMap_Keys[Slot] = Key;
-            KeyMap_Values[Slot] = (uint32_t)GuiInvalidIndex;
-            if(Inserted) *Inserted = GUI_TRUE;
-            return KeyMap_Values[Slot];
+            Map->Keys[Slot]   = Key;
+            Map->Values[Slot] = Value;
+            return;
         }
-        Slot = (Slot + 1) & (KEYMAP_CAPACITY - 1);
+        Slot = (Slot + 1) & Mask;
     }
 }
 
-static void
-GuiKeyMap_Insert(uint64_t Key, uint32_t Value)
+static gui_bool
+GuiKeyMap_Find(uint64_t Key, uint32_t *OutValue, gui_key_map *Map)
 {
-    GuiKeyMap_Init();
+    uint64_t Mask = Map->Capacity - 1;
+    uint64_t Slot = XXH3_64bits(&Key, sizeof(Key)) & Mask;
 
-    uint32_t Hash = (uint32_t)(XXH3_64bits(&Key, sizeof(Key)) & (KEYMAP_CAPACITY - 1));
-    uint32_t Slot = Hash;
-
-    for(;;)
+    for(uint64_t Probe = 0; Probe < Map->Capacity; ++Probe)
     {
-        uint64_t Stored = KeyMap_Keys[Slot];
-        if(Stored == Key || Stored == KEYMAP_EMPTY)
+        if(Map->Values[Slot] == GuiInvalidIndex)
         {
-            KeyMap_Keys[Slot] = Key;
-            KeyMap_Values[Slot] = Value;
-            return;
+            return GUI_FALSE;
         }
-        Slot = (Slot + 1) & (KEYMAP_CAPACITY - 1);
-    }
-}
-
-static int
-GuiKeyMap_Find(uint64_t Key, uint32_t *OutValue)
-{
-    GuiKeyMap_Init();
-
-    uint32_t Hash = (uint32_t)(XXH3_64bits(&Key, sizeof(Key)) & (KEYMAP_CAPACITY - 1));
-    uint32_t Slot = Hash;
 
-    for(;;)
-    {
-        uint64_t Stored = KeyMap_Keys[Slot];
-        if(Stored == KEYMAP_EMPTY) return 0;
-        if(Stored == Key)
+        if(Map->Keys[Slot] == Key)
         {
-            if(OutValue) *OutValue = KeyMap_Values[Slot];
-            return 1;
+            if(OutValue) *OutValue = Map->Values[Slot];
+            return GUI_TRUE;
         }
-        Slot = (Slot + 1) & (KEYMAP_CAPACITY - 1);
+        Slot = (Slot + 1) & Mask;
     }
+
+    return GUI_FALSE;
 }
 
 // -----------------------------------------------------------------------------
@@ -322,8 +298,12 @@ GuiGetLayoutTreeFootprint(uint64_t NodeCount)
     uint64_t NodesEnd   = NodesStart + ((NodeCount + 1) * sizeof(gui_layout_node));
     uint64_t PaintStart = AlignPow2(NodesEnd, AlignOf(gui_paint_properties));
     uint64_t PaintEnd   = PaintStart + (NodeCount * sizeof(gui_paint_properties));
+    uint64_t KeysStart  = AlignPow2(PaintEnd, AlignOf(uint64_t));
+    uint64_t KeysEnd    = KeysStart + (GuiGetKeyMapCapacity(NodeCount) * sizeof(uint64_t));
+    uint64_t ValueStart = AlignPow2(KeysEnd, AlignOf(uint32_t));
+    uint64_t ValueEnd   = ValueStart + (GuiGetKeyMapCapacity(NodeCount) * sizeof(uint32_t));
 
-    gui_memory_footprint Result = { .SizeInBytes = PaintEnd, .Alignment = AlignOf(gui_layout_tree) };
+    gui_memory_footprint Result = { .SizeInBytes = ValueEnd, .Alignment = AlignOf(gui_layout_tree) };
     return Result;
 }
 
@@ -340,12 +320,17 @@ GuiPlaceLayoutTreeInMemory(uint64_t NodeCount, gui_memory_block Block)
         gui_layout_tree      *Tree = GuiPushStruct(&Local, gui_layout_tree);
         gui_layout_node      *Nodes = GuiPushArray(&Local, gui_layout_node, NodeCount + 1);
         gui_paint_properties *Paint = GuiPushArray(&Local, gui_paint_properties, NodeCount);
+        uint64_t             *Keys   = GuiPushArray(&Local, uint64_t, GuiGetKeyMapCapacity(NodeCount));
+        uint32_t             *Values = GuiPushArray(&Local, uint32_t, GuiGetKeyMapCapacity(NodeCount));
 
-        if(Nodes && Paint && Tree)
+        if(Nodes && Paint && Keys && Values && Tree)
         {
             Tree->NodeBuffer.Nodes = Nodes;
             Tree->NodeBuffer.Count = 0;
             Tree->NodeBuffer.Capacity = NodeCount;
+            Tree->KeyMap.Keys = Keys;
+            Tree->KeyMap.Values = Values;
+            Tree->KeyMap.Capacity = GuiGetKeyMapCapacity(NodeCount);
             Tree->PaintBuffer = Paint;
             Tree->RootIndex = 0;
             Tree->CapturedNodeIndex = GuiInvalidIndex;
@@ -369,6 +354,12 @@ GuiPlaceLayoutTreeInMemory(uint64_t NodeCount, gui_memory_block Block)
             Sentinel->Next  = 0;
             Sentinel->Index = GuiInvalidIndex;
 
+            for(uint64_t Slot = 0; Slot < Tree->KeyMap.Capacity; ++Slot)
+            {
+                Tree->KeyMap.Keys[Slot]   = 0;
+                Tree->KeyMap.Values[Slot] = GuiInvalidIndex;
+            }
+
             Result = Tree;
         }
     }
@@ -483,7 +474,7 @@ GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
     if(GuiIsValidLayoutTree(Tree))
     {
         uint32_t FoundIndex = (uint32_t)GuiInvalidIndex;
-        if(GuiKeyMap_Find(Key, &FoundIndex))
+        if(GuiKeyMap_Find(Key, &FoundIndex, &Tree->KeyMap))
         {
             // existing
         }
@@ -492,7 +483,7 @@ GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
             gui_layout_node *Node = GuiGetFreeLayoutNode(&Tree->NodeBuffer);
             if(Node)
             {
-                GuiKeyMap_Insert(Key, Node->Index);
+                GuiKeyMap_Insert(Key, Node->Index, &Tree->KeyMap);
                 FoundIndex = Node->Index;
             }
         }
@@ -502,6 +493,7 @@ GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
         {
             Node->ChildCount = 0;
             Node->Flags      = Flags;
+            Node->Key        = Key;
 
             uint32_t ParentIndex = (Tree->Parent) ? Tree->Parent->Value : (uint32_t)GuiInvalidIndex;
             GuiAppendLayoutNode(Tree->NodeBuffer, ParentIndex, Node->Index);
@@ -513,13 +505,26 @@ GuiCreateNode(uint64_t Key, uint32_t Flags, gui_layout_tree *Tree)
     return Result;
 }
 
+// Pushing a parent also pushes its key as the seed of the keys created below it,
+// see GuiGetChildKey. The root seed is not zero since the mixer maps zero to zero.
+
+static uint64_t
+GuiGetParentSeed(gui_layout_tree *Tree)
+{
+    uint64_t Result = Tree->Parent ? Tree->Parent->Seed : 0x9E3779B97F4A7C15ull;
+    return Result;
+}
+
 static void
 GuiPushParent(uint32_t NodeIndex, gui_layout_tree *Tree, gui_parent_node *ParentNode)
 {
     if(GuiIsValidLayoutTree(Tree) && ParentNode)
     {
+        gui_layout_node *Node = GuiGetLayoutNode(Tree->NodeBuffer, NodeIndex);
+
         ParentNode->Prev  = Tree->Parent;
         ParentNode->Value = NodeIndex;
+        ParentNode->Seed  = GuiIsValidLayoutNode(Node) ? Node->Key : GuiGetParentSeed(Tree);
 
         Tree->Parent = ParentNode;
     }
@@ -534,6 +539,32 @@ GuiPopParent(uint32_t NodeIndex, gui_layout_tree *Tree)
     }
 }
 
+static uint64_t
+GuiMixChildKey(uint64_t Value)
+{
+    uint64_t Result = Value;
+    Result ^= Result >> 33;
+    Result *= 0xFF51AFD7ED558CCDull;
+    Result ^= Result >> 33;
+    return Result;
+}
+
+// Combines the current parent's seed with a key that only has to be unique among
+// siblings, like an index or a pre-hashed literal.
+
+static uint64_t
+GuiGetChildKey(uint64_t LocalKey, gui_layout_tree *Tree)
+{
+    uint64_t Result = 0;
+
+    if(GuiIsValidLayoutTree(Tree))
+    {
+        Result = GuiMixChildKey(GuiGetParentSeed(Tree) ^ ((LocalKey + 1) * 0x9E3779B97F4A7C15ull));
+    }
+
+    return Result;
+}
+
 static uint32_t
 GuiFindChild(uint32_t NodeIndex, uint32_t FindIndex, gui_layout_tree *Tree)
 {
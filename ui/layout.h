@@ -96,6 +96,7 @@ static uint32_t GuiCreateNode   (uint64_t Key, uint32_t Flags, gui_layout_tree *
 static gui_bool GuiAppendChild  (uint32_t ParentIndex, uint32_t ChildIndex, gui_layout_tree *Tree);
 static void     GuiPushParent   (uint32_t NodeIndex, gui_layout_tree *Tree, gui_parent_node *Node);
 static void     GuiPopParent    (uint32_t NodeIndex, gui_layout_tree *Tree);
+static uint64_t GuiGetChildKey  (uint64_t LocalKey, gui_layout_tree *Tree);
 
 // =============================================================================
 // Node Queries